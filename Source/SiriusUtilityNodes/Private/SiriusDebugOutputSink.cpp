@@ -0,0 +1,210 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusDebugOutputSink.h"
+
+#include "SiriusEncoding.h"
+#include "SiriusUtilityNodes.h"
+#include "CoreGlobals.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarSiriusDebugOutputFile(
+	TEXT("Sirius.DebugOutputFile"),
+	0,
+	TEXT("When enabled, Print String Formatted writes its log output to a dedicated file in Saved/Logs/Sirius instead of the engine log."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSiriusDebugOutputFileFlushSize(
+	TEXT("Sirius.DebugOutputFile.FlushSize"),
+	256,
+	TEXT("Size in KB of buffered debug output after which it is written to disk."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSiriusDebugOutputFileFlushInterval(
+	TEXT("Sirius.DebugOutputFile.FlushInterval"),
+	1.0f,
+	TEXT("Maximum time in seconds buffered debug output is kept in memory before it is written to disk."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSiriusDebugOutputFileMaxSize(
+	TEXT("Sirius.DebugOutputFile.MaxSize"),
+	64,
+	TEXT("Size in MB after which a new debug output file is started."),
+	ECVF_Default);
+
+FSiriusDebugOutputSink& FSiriusDebugOutputSink::Get()
+{
+	static FSiriusDebugOutputSink Sink;
+	return Sink;
+}
+
+bool FSiriusDebugOutputSink::IsEnabled()
+{
+	return CVarSiriusDebugOutputFile.GetValueOnAnyThread() != 0;
+}
+
+FSiriusDebugOutputSink::FSiriusDebugOutputSink()
+	: CurrentFileSize(0),
+	  FileIndex(0),
+	  SessionTimestamp(FDateTime::Now().ToString()),
+	  LastFlushTime(0.0)
+{
+}
+
+FSiriusDebugOutputSink::~FSiriusDebugOutputSink()
+{
+	// Shutdown is expected to have been called by the module already, this only catches output written after it.
+	Flush();
+}
+
+void FSiriusDebugOutputSink::Initialize()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSiriusDebugOutputSink::OnTick));
+	}
+}
+
+void FSiriusDebugOutputSink::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	Flush();
+
+	FScopeLock FileLock(&FileCriticalSection);
+	FileHandle.Reset();
+}
+
+void FSiriusDebugOutputSink::WriteLine(const FStringView Line)
+{
+	TUtf8StringBuilder<256> LineUtf8;
+	FSiriusEncoding::AppendUtf8(Line, LineUtf8);
+	WriteLine(LineUtf8.ToView());
+}
+
+void FSiriusDebugOutputSink::WriteLine(const FUtf8StringView Line)
+{
+	// Same prefix as the engine log, so lines can be correlated with it.
+	TStringBuilder<64> Prefix;
+	Prefix.Appendf(TEXT("[%s][%3llu]"), *FDateTime::Now().ToString(TEXT("%Y.%m.%d-%H.%M.%S:%s")), GFrameCounter % 1000);
+	TUtf8StringBuilder<64> PrefixUtf8;
+	FSiriusEncoding::AppendUtf8(Prefix.ToView(), PrefixUtf8);
+
+	FScopeLock Lock(&CriticalSection);
+
+	Buffer.Append(reinterpret_cast<const uint8*>(PrefixUtf8.GetData()), PrefixUtf8.Len());
+	Buffer.Append(reinterpret_cast<const uint8*>(Line.GetData()), Line.Len());
+	Buffer.Add('\n');
+
+	if (Buffer.Num() >= FMath::Max(CVarSiriusDebugOutputFileFlushSize.GetValueOnAnyThread(), 1) * 1024)
+	{
+		StartWriteLocked();
+	}
+}
+
+void FSiriusDebugOutputSink::Flush()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	WriteTask.Wait();
+	LastFlushTime = FPlatformTime::Seconds();
+
+	if (Buffer.Num() > 0)
+	{
+		Swap(Buffer, WriteBuffer);
+		WriteToFile();
+	}
+}
+
+FString FSiriusDebugOutputSink::GetCurrentFilename() const
+{
+	FScopeLock FileLock(&FileCriticalSection);
+	return CurrentFilename;
+}
+
+bool FSiriusDebugOutputSink::OnTick(float /*DeltaTime*/)
+{
+	FScopeLock Lock(&CriticalSection);
+	if (FPlatformTime::Seconds() - LastFlushTime >= CVarSiriusDebugOutputFileFlushInterval.GetValueOnGameThread())
+	{
+		StartWriteLocked();
+	}
+	return true;
+}
+
+void FSiriusDebugOutputSink::StartWriteLocked()
+{
+	// A busy writer picks up the buffer on the next line or tick after it finished, the buffer keeps growing until then.
+	if (Buffer.Num() == 0 || !WriteTask.IsCompleted())
+	{
+		return;
+	}
+
+	LastFlushTime = FPlatformTime::Seconds();
+
+	// The writer emptied WriteBuffer, so swapping keeps the capacity of both buffers.
+	Swap(Buffer, WriteBuffer);
+	WriteTask = UE::Tasks::Launch(TEXT("SiriusDebugOutputWrite"), [this]()
+	{
+		WriteToFile();
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FSiriusDebugOutputSink::WriteToFile()
+{
+	FScopeLock FileLock(&FileCriticalSection);
+
+	const int64 MaxFileSize = static_cast<int64>(FMath::Max(CVarSiriusDebugOutputFileMaxSize.GetValueOnAnyThread(), 1)) * 1024 * 1024;
+	if (!FileHandle.IsValid() || CurrentFileSize + WriteBuffer.Num() > MaxFileSize)
+	{
+		if (!OpenNextFile())
+		{
+			// Drop the output rather than letting the buffers grow without bounds.
+			WriteBuffer.Reset();
+			return;
+		}
+	}
+
+	if (FileHandle->Write(WriteBuffer.GetData(), WriteBuffer.Num()))
+	{
+		FileHandle->Flush();
+		CurrentFileSize += WriteBuffer.Num();
+	}
+	else
+	{
+		UE_LOG(LogSiriusUtilityNodes, Warning, TEXT("Failed to write debug output to %s"), *CurrentFilename);
+	}
+
+	WriteBuffer.Reset();
+}
+
+bool FSiriusDebugOutputSink::OpenNextFile()
+{
+	FileHandle.Reset();
+
+	const FString Directory = FPaths::ProjectLogDir() / TEXT("Sirius");
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*Directory);
+
+	CurrentFilename = Directory / FString::Printf(TEXT("%s_%s_%02d.log"), FApp::GetProjectName(), *SessionTimestamp, FileIndex++);
+	CurrentFileSize = 0;
+
+	FileHandle.Reset(PlatformFile.OpenWrite(*CurrentFilename, /*bAppend*/ true, /*bAllowRead*/ true));
+	if (!FileHandle.IsValid())
+	{
+		UE_LOG(LogSiriusUtilityNodes, Warning, TEXT("Failed to open debug output file %s"), *CurrentFilename);
+		return false;
+	}
+
+	CurrentFileSize = FileHandle->Size();
+	return true;
+}
@@ -0,0 +1,170 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusEncoding.h"
+
+namespace SiriusEncoding
+{
+	static constexpr ANSICHAR HexDigitsLower[] = "0123456789abcdef";
+	static constexpr ANSICHAR HexDigitsUpper[] = "0123456789ABCDEF";
+
+	/** The four binary digits of each nibble, so a byte is written by two lookups */
+	static constexpr ANSICHAR NibbleBits[] =
+		"00000001001000110100010101100111"
+		"10001001101010111100110111101111";
+
+	static constexpr ANSICHAR Base64Digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	/** Reserves the characters at the end of the builder and returns them, so they can be written in place */
+	template <typename CharType>
+	static CharType* AddUninitialized(TStringBuilderBase<CharType>& Out, const int32 Count)
+	{
+		const int32 Offset = Out.AddUninitialized(Count);
+		return Out.GetData() + Offset;
+	}
+
+	static void WriteNibbleBits(const uint32 Nibble, TCHAR* Dest)
+	{
+		const ANSICHAR* Bits = NibbleBits + Nibble * 4;
+		Dest[0] = Bits[0];
+		Dest[1] = Bits[1];
+		Dest[2] = Bits[2];
+		Dest[3] = Bits[3];
+	}
+}
+
+void FSiriusEncoding::AppendHex(const uint64 Value, const int32 MinDigits, const bool bUpperCase, FStringBuilderBase& Out)
+{
+	using namespace SiriusEncoding;
+
+	// Each set nibble is a digit, zero still has one.
+	const int32 NumSignificant = Value == 0 ? 1 : (67 - static_cast<int32>(FMath::CountLeadingZeros64(Value))) / 4;
+	const int32 NumDigits = FMath::Max(NumSignificant, MinDigits);
+
+	const ANSICHAR* Digits = bUpperCase ? HexDigitsUpper : HexDigitsLower;
+	TCHAR* Dest = AddUninitialized(Out, NumDigits);
+	uint64 Remaining = Value;
+	for (int32 Index = NumDigits - 1; Index >= 0; --Index)
+	{
+		Dest[Index] = Digits[Remaining & 0xF];
+		Remaining >>= 4;
+	}
+}
+
+void FSiriusEncoding::AppendBinary(const uint64 Value, const int32 MinDigits, FStringBuilderBase& Out)
+{
+	using namespace SiriusEncoding;
+
+	const int32 NumSignificant = Value == 0 ? 1 : 64 - static_cast<int32>(FMath::CountLeadingZeros64(Value));
+	const int32 NumDigits = FMath::Max(NumSignificant, MinDigits);
+
+	TCHAR* Dest = AddUninitialized(Out, NumDigits);
+	int32 Index = NumDigits;
+	uint64 Remaining = Value;
+
+	// Whole nibbles by lookup, then the digits left at the front one by one.
+	for (; Index >= 4; Index -= 4)
+	{
+		WriteNibbleBits(static_cast<uint32>(Remaining & 0xF), Dest + Index - 4);
+		Remaining >>= 4;
+	}
+	for (; Index > 0; --Index)
+	{
+		Dest[Index - 1] = static_cast<TCHAR>(TEXT('0') + (Remaining & 1));
+		Remaining >>= 1;
+	}
+}
+
+void FSiriusEncoding::AppendHex(const TConstArrayView<uint8> Bytes, const bool bUpperCase, FStringBuilderBase& Out)
+{
+	using namespace SiriusEncoding;
+
+	const ANSICHAR* Digits = bUpperCase ? HexDigitsUpper : HexDigitsLower;
+	TCHAR* Dest = AddUninitialized(Out, Bytes.Num() * 2);
+	for (const uint8 Byte : Bytes)
+	{
+		*Dest++ = Digits[Byte >> 4];
+		*Dest++ = Digits[Byte & 0xF];
+	}
+}
+
+void FSiriusEncoding::AppendBinary(const TConstArrayView<uint8> Bytes, FStringBuilderBase& Out)
+{
+	using namespace SiriusEncoding;
+
+	TCHAR* Dest = AddUninitialized(Out, Bytes.Num() * 8);
+	for (const uint8 Byte : Bytes)
+	{
+		WriteNibbleBits(Byte >> 4, Dest);
+		WriteNibbleBits(Byte & 0xF, Dest + 4);
+		Dest += 8;
+	}
+}
+
+void FSiriusEncoding::AppendBase64(const TConstArrayView<uint8> Bytes, FStringBuilderBase& Out)
+{
+	using namespace SiriusEncoding;
+
+	const int32 NumBytes = Bytes.Num();
+	const uint8* Source = Bytes.GetData();
+	TCHAR* Dest = AddUninitialized(Out, (NumBytes + 2) / 3 * 4);
+
+	// Every three bytes are four digits of six bits.
+	int32 Index = 0;
+	for (; Index + 3 <= NumBytes; Index += 3)
+	{
+		const uint32 Triple = (Source[Index] << 16) | (Source[Index + 1] << 8) | Source[Index + 2];
+		Dest[0] = Base64Digits[(Triple >> 18) & 0x3F];
+		Dest[1] = Base64Digits[(Triple >> 12) & 0x3F];
+		Dest[2] = Base64Digits[(Triple >> 6) & 0x3F];
+		Dest[3] = Base64Digits[Triple & 0x3F];
+		Dest += 4;
+	}
+
+	const int32 NumRemaining = NumBytes - Index;
+	if (NumRemaining > 0)
+	{
+		const uint32 Triple = (Source[Index] << 16) | (NumRemaining == 2 ? Source[Index + 1] << 8 : 0);
+		Dest[0] = Base64Digits[(Triple >> 18) & 0x3F];
+		Dest[1] = Base64Digits[(Triple >> 12) & 0x3F];
+		Dest[2] = NumRemaining == 2 ? Base64Digits[(Triple >> 6) & 0x3F] : TEXT('=');
+		Dest[3] = TEXT('=');
+	}
+}
+
+void FSiriusEncoding::AppendUtf8(const FStringView Text, FUtf8StringBuilderBase& Out)
+{
+	using namespace SiriusEncoding;
+
+	const TCHAR* Chars = Text.GetData();
+	const int32 Len = Text.Len();
+
+	int32 Index = 0;
+	while (Index < Len)
+	{
+		int32 AsciiEnd = Index;
+		while (AsciiEnd < Len && Chars[AsciiEnd] < 0x80)
+		{
+			++AsciiEnd;
+		}
+
+		if (AsciiEnd > Index)
+		{
+			UTF8CHAR* Dest = AddUninitialized(Out, AsciiEnd - Index);
+			for (; Index < AsciiEnd; ++Index)
+			{
+				*Dest++ = static_cast<UTF8CHAR>(Chars[Index]);
+			}
+			continue;
+		}
+
+		// Convert up to the next ASCII character, surrogate pairs stay together as the run only ends at ASCII.
+		int32 RunEnd = Index + 1;
+		while (RunEnd < Len && Chars[RunEnd] >= 0x80)
+		{
+			++RunEnd;
+		}
+		const FTCHARToUTF8 Converted(Chars + Index, RunEnd - Index);
+		Out.Append(reinterpret_cast<const UTF8CHAR*>(Converted.Get()), Converted.Length());
+		Index = RunEnd;
+	}
+}
@@ -0,0 +1,88 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusFormatAsyncAction.h"
+
+#include "SiriusPatternTable.h"
+#include "SiriusStringFormatPattern.h"
+
+FSiriusFormatAsyncAction::FSiriusFormatAsyncAction(const FLatentActionInfo& LatentInfo, const int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs, FString& OutResult)
+	: Result(OutResult),
+	  ExecutionFunction(LatentInfo.ExecutionFunction),
+	  OutputLink(LatentInfo.Linkage),
+	  CallbackTarget(LatentInfo.CallbackTarget)
+{
+	Launch(PatternId, InPattern, InArgs);
+}
+
+FSiriusFormatAsyncAction::~FSiriusFormatAsyncAction()
+{
+	Cancel();
+}
+
+void FSiriusFormatAsyncAction::Restart(const int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs)
+{
+	Cancel();
+	Launch(PatternId, InPattern, InArgs);
+}
+
+void FSiriusFormatAsyncAction::UpdateOperation(FLatentResponse& Response)
+{
+	const bool bCompleted = Task.IsCompleted();
+	if (bCompleted)
+	{
+		// The task no longer touches the state, so the result can be moved out.
+		Result = MoveTemp(State->Result);
+	}
+
+	Response.FinishAndTriggerIf(bCompleted, ExecutionFunction, OutputLink, CallbackTarget);
+}
+
+#if WITH_EDITOR
+FString FSiriusFormatAsyncAction::GetDescription() const
+{
+	return FString::Printf(TEXT("Formatting a pattern of %d characters with %d arguments"), State->Pattern.Len(), State->Args.Num());
+}
+#endif
+
+void FSiriusFormatAsyncAction::Launch(const int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs)
+{
+	// The Blueprint may change the arguments while the task runs, so it works on a copy.
+	State = MakeShared<FState, ESPMode::ThreadSafe>();
+	State->Pattern = InPattern;
+	State->Args = InArgs;
+
+	// Literal patterns are looked up here, as the table may be reloaded on the game thread while the task runs.
+	if (PatternId != 0)
+	{
+		TArray<FSiriusStringFormatSegment> LocalSegments;
+		const TConstArrayView<FSiriusStringFormatSegment> Segments = FSiriusPatternTable::Get().FindOrParse(PatternId, InPattern, LocalSegments);
+		State->Segments.Append(Segments.GetData(), Segments.Num());
+	}
+
+	Task = UE::Tasks::Launch(TEXT("SiriusFormatAsync"), [TaskState = State]()
+	{
+		if (TaskState->bCanceled.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		if (TaskState->Segments.Num() == 0)
+		{
+			FSiriusStringFormatPattern::Parse(TaskState->Pattern, TaskState->Segments);
+		}
+
+		TStringBuilder<1024> Builder;
+		FSiriusStringFormatPattern::Format(TaskState->Pattern, TaskState->Segments, TaskState->Args, Builder);
+		TaskState->Result = FString(Builder.ToView());
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FSiriusFormatAsyncAction::Cancel()
+{
+	// The task keeps its own reference to the state, so it can still finish safely after this.
+	if (State.IsValid())
+	{
+		State->bCanceled.store(true, std::memory_order_relaxed);
+		State.Reset();
+	}
+}
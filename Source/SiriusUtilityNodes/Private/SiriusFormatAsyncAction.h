@@ -0,0 +1,57 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LatentActions.h"
+#include "SiriusStringFormatPattern.h"
+#include "SiriusStringLibrary.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+/**
+ * Latent action of USiriusStringLibrary::FormatAsync. Formats a copy of the pattern and arguments on a background task
+ * and writes the result to the node's output on the game thread, once the task finished. The copy is made on the game thread
+ * for every call and restart, and struct and array arguments arrive already converted to text.
+ *
+ * The latent action manager destroys the action together with the object that started it, which cancels the task.
+ * Tasks that already started formatting run to completion, but their result is discarded.
+ */
+class FSiriusFormatAsyncAction final : public FPendingLatentAction
+{
+public:
+	FSiriusFormatAsyncAction(const FLatentActionInfo& LatentInfo, int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs, FString& OutResult);
+	virtual ~FSiriusFormatAsyncAction() override;
+
+	/** Cancels the pending format and starts over with new arguments, so only the latest result is output */
+	void Restart(int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs);
+
+	//~ Begin FPendingLatentAction Interface
+	virtual void UpdateOperation(FLatentResponse& Response) override;
+#if WITH_EDITOR
+	virtual FString GetDescription() const override;
+#endif
+	//~ End FPendingLatentAction Interface
+
+private:
+	/** Everything the task reads and writes, shared with the task as it may outlive the action */
+	struct FState
+	{
+		FString Pattern;
+		TArray<FSiriusStringFormatArgument> Args;
+		TArray<FSiriusStringFormatSegment> Segments;
+		FString Result;
+		std::atomic<bool> bCanceled{false};
+	};
+
+	void Launch(int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs);
+	void Cancel();
+
+	TSharedPtr<FState, ESPMode::ThreadSafe> State;
+	UE::Tasks::TTask<void> Task;
+
+	FString& Result;
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+};
@@ -0,0 +1,134 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusFormatNameCache.h"
+
+#include "SiriusUtilityNodes.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarSiriusFormatNameCacheMaxEntries(
+	TEXT("Sirius.FormatNameCache.MaxEntries"),
+	1024,
+	TEXT("Number of names each Format Name node remembers before it starts over. 0 disables the cache."),
+	ECVF_Default);
+
+static FAutoConsoleCommand CmdSiriusFormatNameCacheStats(
+	TEXT("Sirius.FormatNameCache.Stats"),
+	TEXT("Lists the hit rate of every Format Name call site."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FSiriusFormatNameCache::Get().DumpStats();
+	}));
+
+static FAutoConsoleCommand CmdSiriusFormatNameCacheReset(
+	TEXT("Sirius.FormatNameCache.Reset"),
+	TEXT("Removes all cached Format Name results and statistics."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FSiriusFormatNameCache::Get().Reset();
+	}));
+
+FSiriusFormatNameCache& FSiriusFormatNameCache::Get()
+{
+	static FSiriusFormatNameCache Cache;
+	return Cache;
+}
+
+bool FSiriusFormatNameCache::IsEnabled()
+{
+	return IsInGameThread() && CVarSiriusFormatNameCacheMaxEntries.GetValueOnGameThread() > 0;
+}
+
+uint32 FSiriusFormatNameCache::HashKey(const int64 PatternId, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args)
+{
+	// Argument names are the same for every call of a call site, only the values need hashing.
+	// Literal patterns were already hashed into their ID when the Blueprint was compiled.
+	uint32 Hash = PatternId != 0 ? GetTypeHash(PatternId) : FCrc::StrCrc32(*Pattern);
+	for (const FSiriusStringFormatArgument& Arg : Args)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Arg));
+	}
+	return Hash;
+}
+
+bool FSiriusFormatNameCache::Matches(const FEntry& Entry, const int64 PatternId, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args)
+{
+	if (Entry.PatternId != PatternId || Entry.Args != Args)
+	{
+		return false;
+	}
+	return PatternId != 0 || Entry.Pattern.Equals(Pattern, ESearchCase::CaseSensitive);
+}
+
+bool FSiriusFormatNameCache::Find(const FName CallSite, const int64 PatternId, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args, FName& OutName)
+{
+	check(IsInGameThread());
+
+	const uint32 Hash = HashKey(PatternId, Pattern, Args);
+
+	FCallSite& Site = CallSites.FindOrAdd(CallSite);
+	if (const TArray<FEntry, TInlineAllocator<1>>* Bucket = Site.Entries.Find(Hash))
+	{
+		for (const FEntry& Entry : *Bucket)
+		{
+			if (Matches(Entry, PatternId, Pattern, Args))
+			{
+				++Site.Hits;
+				OutName = Entry.Name;
+				return true;
+			}
+		}
+	}
+
+	++Site.Misses;
+	return false;
+}
+
+void FSiriusFormatNameCache::Store(const FName CallSite, const int64 PatternId, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args, const FName Name)
+{
+	check(IsInGameThread());
+
+	const int32 MaxEntries = CVarSiriusFormatNameCacheMaxEntries.GetValueOnGameThread();
+	const uint32 Hash = HashKey(PatternId, Pattern, Args);
+
+	// Call sites producing unbounded combinations, like names with a counter, start over rather than growing forever.
+	FCallSite& Site = CallSites.FindOrAdd(CallSite);
+	if (Site.NumEntries >= MaxEntries)
+	{
+		Site.Entries.Reset();
+		Site.NumEntries = 0;
+	}
+
+	FEntry& Entry = Site.Entries.FindOrAdd(Hash).AddDefaulted_GetRef();
+	Entry.PatternId = PatternId;
+	if (PatternId == 0)
+	{
+		Entry.Pattern = Pattern;
+	}
+	Entry.Args = Args;
+	Entry.Name = Name;
+	++Site.NumEntries;
+}
+
+void FSiriusFormatNameCache::Reset()
+{
+	CallSites.Empty();
+}
+
+void FSiriusFormatNameCache::DumpStats() const
+{
+	uint64 TotalHits = 0;
+	uint64 TotalMisses = 0;
+	for (const TPair<FName, FCallSite>& Pair : CallSites)
+	{
+		const uint64 Total = Pair.Value.Hits + Pair.Value.Misses;
+		UE_LOG(LogSiriusUtilityNodes, Display, TEXT("%s: %d names, %llu hits, %llu misses (%.1f%%)"),
+		       *Pair.Key.ToString(), Pair.Value.NumEntries, Pair.Value.Hits, Pair.Value.Misses, Total > 0 ? 100.0 * Pair.Value.Hits / Total : 0.0);
+
+		TotalHits += Pair.Value.Hits;
+		TotalMisses += Pair.Value.Misses;
+	}
+
+	const uint64 Total = TotalHits + TotalMisses;
+	UE_LOG(LogSiriusUtilityNodes, Display, TEXT("%d call sites: %llu hits, %llu misses (%.1f%%)"),
+	       CallSites.Num(), TotalHits, TotalMisses, Total > 0 ? 100.0 * TotalHits / Total : 0.0);
+}
@@ -0,0 +1,63 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SiriusStringLibrary.h"
+
+/**
+ * Remembers the names produced by every Format Name call site, by pattern and argument values. Repeated combinations
+ * return the existing name without formatting it or looking it up in the name table again.
+ *
+ * Literal patterns are identified by their pattern ID, so a lookup only hashes and compares the argument values.
+ * Each call site keeps at most "Sirius.FormatNameCache.MaxEntries" names, after which it starts over.
+ *
+ * The cache is only used on the game thread and isn't locked, like the FSiriusFormatResultCache.
+ * Use "Sirius.FormatNameCache.Stats" to list the hit rate per call site.
+ */
+class FSiriusFormatNameCache
+{
+public:
+	static FSiriusFormatNameCache& Get();
+
+	/** Returns true if the cache should be used, which is only on the game thread */
+	static bool IsEnabled();
+
+	/** Looks up the name a call site previously produced for the pattern and arguments, returns false if there is none. PatternId is 0 for linked patterns. */
+	bool Find(FName CallSite, int64 PatternId, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args, FName& OutName);
+
+	/** Stores a freshly formatted name for a call site */
+	void Store(FName CallSite, int64 PatternId, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args, FName Name);
+
+	/** Removes all cached names and statistics */
+	void Reset();
+
+	/** Writes the hit rate and number of names of each call site to the log */
+	void DumpStats() const;
+
+private:
+	struct FEntry
+	{
+		/** The ID of a literal pattern, the pattern itself is only kept for linked patterns */
+		int64 PatternId = 0;
+		FString Pattern;
+		TArray<FSiriusStringFormatArgument> Args;
+		FName Name;
+	};
+
+	struct FCallSite
+	{
+		/** Entries by the hash of their pattern and arguments, so a lookup doesn't need to copy the arguments into a key */
+		TMap<uint32, TArray<FEntry, TInlineAllocator<1>>> Entries;
+		int32 NumEntries = 0;
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+	};
+
+	static uint32 HashKey(int64 PatternId, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args);
+
+	/** Returns true if the entry was stored for the pattern and arguments */
+	static bool Matches(const FEntry& Entry, int64 PatternId, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args);
+
+	TMap<FName, FCallSite> CallSites;
+};
@@ -0,0 +1,152 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusFormatResultCache.h"
+
+#include "SiriusStringFormatPattern.h"
+#include "SiriusUtilityNodes.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarSiriusFormatCache(
+	TEXT("Sirius.FormatCache"),
+	1,
+	TEXT("When disabled, Format String nodes with Cache Result enabled format on every evaluation. Useful to measure the effect of the cache."),
+	ECVF_Default);
+
+static FAutoConsoleCommand CmdSiriusFormatCacheStats(
+	TEXT("Sirius.FormatCache.Stats"),
+	TEXT("Lists the hit rate of every cached Format String call site."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FSiriusFormatResultCache::Get().DumpStats();
+	}));
+
+static FAutoConsoleCommand CmdSiriusFormatCacheReset(
+	TEXT("Sirius.FormatCache.Reset"),
+	TEXT("Removes all cached Format String results and statistics."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FSiriusFormatResultCache::Get().Reset();
+	}));
+
+FSiriusFormatResultCache& FSiriusFormatResultCache::Get()
+{
+	static FSiriusFormatResultCache Cache;
+	return Cache;
+}
+
+bool FSiriusFormatResultCache::IsEnabled()
+{
+	return IsInGameThread() && CVarSiriusFormatCache.GetValueOnGameThread() != 0;
+}
+
+const FString& FSiriusFormatResultCache::FindOrFormat(const UObject* Owner, const FName CallSite, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args)
+{
+	check(IsInGameThread());
+
+	const FKey Key(Owner, CallSite);
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		if (Entries.Num() >= PruneThreshold)
+		{
+			PruneDestroyedOwners();
+		}
+		Entry = &Entries.Add(Key);
+	}
+
+	const bool bSamePattern = Entry->bHasResult && Entry->Pattern.Equals(Pattern, ESearchCase::CaseSensitive);
+	if (bSamePattern && Entry->Args == Args)
+	{
+		++Entry->Hits;
+		return Entry->Result;
+	}
+
+	++Entry->Misses;
+
+	// Only copy what changed, assigning into the existing strings and arrays reuses their allocations.
+	// The segments are kept with the pattern, so changing arguments don't parse it again.
+	if (!bSamePattern)
+	{
+		Entry->Pattern = Pattern;
+		Entry->Segments.Reset();
+		FSiriusStringFormatPattern::Parse(Pattern, Entry->Segments);
+	}
+	if (Entry->Args.Num() != Args.Num())
+	{
+		Entry->Args = Args;
+	}
+	else
+	{
+		for (int32 Index = 0; Index < Args.Num(); ++Index)
+		{
+			if (Entry->Args[Index] != Args[Index])
+			{
+				Entry->Args[Index] = Args[Index];
+			}
+		}
+	}
+
+	TStringBuilder<256> Builder;
+	FSiriusStringFormatPattern::Format(Pattern, Entry->Segments, Args, Builder);
+
+	Entry->Result.Reset(Builder.Len());
+	Entry->Result.Append(Builder.GetData(), Builder.Len());
+	Entry->bHasResult = true;
+	return Entry->Result;
+}
+
+void FSiriusFormatResultCache::Reset()
+{
+	Entries.Empty();
+	PruneThreshold = 256;
+}
+
+void FSiriusFormatResultCache::PruneDestroyedOwners()
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		// Entries without an owner have a null key, which never resolves either.
+		if (It.Key().Key != TObjectKey<UObject>() && It.Key().Key.ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Don't prune again on every new entry when most owners are still alive.
+	PruneThreshold = FMath::Max(256, Entries.Num() * 2);
+}
+
+void FSiriusFormatResultCache::DumpStats() const
+{
+	struct FCallSiteStats
+	{
+		int32 NumOwners = 0;
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+	};
+
+	TMap<FName, FCallSiteStats> CallSites;
+	for (const TPair<FKey, FEntry>& Pair : Entries)
+	{
+		FCallSiteStats& Stats = CallSites.FindOrAdd(Pair.Key.Value);
+		++Stats.NumOwners;
+		Stats.Hits += Pair.Value.Hits;
+		Stats.Misses += Pair.Value.Misses;
+	}
+
+	uint64 TotalHits = 0;
+	uint64 TotalMisses = 0;
+	for (const TPair<FName, FCallSiteStats>& Pair : CallSites)
+	{
+		const uint64 Total = Pair.Value.Hits + Pair.Value.Misses;
+		UE_LOG(LogSiriusUtilityNodes, Display, TEXT("%s: %d objects, %llu hits, %llu misses (%.1f%%)"),
+		       *Pair.Key.ToString(), Pair.Value.NumOwners, Pair.Value.Hits, Pair.Value.Misses, Total > 0 ? 100.0 * Pair.Value.Hits / Total : 0.0);
+
+		TotalHits += Pair.Value.Hits;
+		TotalMisses += Pair.Value.Misses;
+	}
+
+	const uint64 Total = TotalHits + TotalMisses;
+	UE_LOG(LogSiriusUtilityNodes, Display, TEXT("%d call sites: %llu hits, %llu misses (%.1f%%)"),
+	       CallSites.Num(), TotalHits, TotalMisses, Total > 0 ? 100.0 * TotalHits / Total : 0.0);
+}
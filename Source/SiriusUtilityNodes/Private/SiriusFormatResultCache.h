@@ -0,0 +1,64 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SiriusStringFormatPattern.h"
+#include "SiriusStringLibrary.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Remembers the last pattern, arguments and result of every Format String call site that has caching enabled, separately
+ * for every object running the Blueprint. A call site only formats again once its pattern or any of its argument values changed.
+ *
+ * The cache is only used on the game thread and isn't locked. Entries of destroyed objects are pruned as new entries are added.
+ * Use "Sirius.FormatCache.Stats" to list the hit rate per call site and "Sirius.FormatCache 0" to bypass the cache.
+ */
+class FSiriusFormatResultCache
+{
+public:
+	static FSiriusFormatResultCache& Get();
+
+	/** Returns true if the cache should be used, which is only on the game thread */
+	static bool IsEnabled();
+
+	/**
+	 * Returns the previous result of a call site if its pattern and arguments didn't change, otherwise formats and remembers the new result.
+	 * Only the pattern and arguments that changed are copied into the entry, reusing its allocations. The pattern is only parsed when it changed.
+	 *
+	 * @param Owner			The object running the Blueprint, each object has its own results
+	 * @param CallSite		Unique name of the call site, generated during node expansion
+	 * @param Pattern		The pattern to format
+	 * @param Args			The arguments to format
+	 * @return				The result, valid until the call site of the object is formatted again
+	 */
+	const FString& FindOrFormat(const UObject* Owner, FName CallSite, const FString& Pattern, const TArray<FSiriusStringFormatArgument>& Args);
+
+	/** Removes all cached results and statistics */
+	void Reset();
+
+	/** Writes the hit rate of each call site to the log */
+	void DumpStats() const;
+
+private:
+	using FKey = TPair<TObjectKey<UObject>, FName>;
+
+	struct FEntry
+	{
+		FString Pattern;
+		TArray<FSiriusStringFormatSegment> Segments;
+		TArray<FSiriusStringFormatArgument> Args;
+		FString Result;
+		bool bHasResult = false;
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+	};
+
+	/** Removes the entries of objects that were destroyed */
+	void PruneDestroyedOwners();
+
+	TMap<FKey, FEntry> Entries;
+
+	/** Number of entries after which destroyed owners are pruned again */
+	int32 PruneThreshold = 256;
+};
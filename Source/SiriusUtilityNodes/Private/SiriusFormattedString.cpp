@@ -0,0 +1,297 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusFormattedString.h"
+
+#include "SiriusUtilityNodes.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/Package.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "INotifyFieldValueChanged.h"
+#endif
+
+USiriusFormattedString* USiriusFormattedString::CreateFormattedString(UObject* Outer, const FString& Pattern)
+{
+	USiriusFormattedString* FormattedString = NewObject<USiriusFormattedString>(Outer ? Outer : GetTransientPackage());
+	FormattedString->SetPattern(Pattern);
+	return FormattedString;
+}
+
+void USiriusFormattedString::BeginDestroy()
+{
+	UnbindAllFields();
+
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
+
+void USiriusFormattedString::SetPattern(const FString& InPattern)
+{
+	if (!InPattern.Equals(Pattern.GetPattern(), ESearchCase::CaseSensitive))
+	{
+		Pattern = FSiriusStringFormatPattern(InPattern);
+		MarkDirty();
+	}
+}
+
+FString USiriusFormattedString::GetString()
+{
+	if (bDirty)
+	{
+		UpdateString();
+	}
+	return FormattedString;
+}
+
+void USiriusFormattedString::SetIntArgument(const FString& ArgumentName, const int32 Value)
+{
+	FSiriusStringFormatArgument Argument;
+	Argument.ArgumentName = ArgumentName;
+	Argument.ArgumentValueType = ESiriusStringFormatArgumentType::Int;
+	Argument.ArgumentValueInt = Value;
+	SetArgument(Argument);
+}
+
+void USiriusFormattedString::SetInt64Argument(const FString& ArgumentName, const int64 Value)
+{
+	FSiriusStringFormatArgument Argument;
+	Argument.ArgumentName = ArgumentName;
+	Argument.ArgumentValueType = ESiriusStringFormatArgumentType::Int64;
+	Argument.ArgumentValueInt64 = Value;
+	SetArgument(Argument);
+}
+
+void USiriusFormattedString::SetFloatArgument(const FString& ArgumentName, const float Value)
+{
+	FSiriusStringFormatArgument Argument;
+	Argument.ArgumentName = ArgumentName;
+	Argument.ArgumentValueType = ESiriusStringFormatArgumentType::Float;
+	Argument.ArgumentValueFloat = Value;
+	SetArgument(Argument);
+}
+
+void USiriusFormattedString::SetDoubleArgument(const FString& ArgumentName, const double Value)
+{
+	FSiriusStringFormatArgument Argument;
+	Argument.ArgumentName = ArgumentName;
+	Argument.ArgumentValueType = ESiriusStringFormatArgumentType::Double;
+	Argument.ArgumentValueDouble = Value;
+	SetArgument(Argument);
+}
+
+void USiriusFormattedString::SetStringArgument(const FString& ArgumentName, const FString& Value)
+{
+	FSiriusStringFormatArgument Argument;
+	Argument.ArgumentName = ArgumentName;
+	Argument.ArgumentValueType = ESiriusStringFormatArgumentType::String;
+	Argument.ArgumentValue = Value;
+	SetArgument(Argument);
+}
+
+void USiriusFormattedString::SetTextArgument(const FString& ArgumentName, const FText& Value)
+{
+	SetStringArgument(ArgumentName, Value.ToString());
+}
+
+void USiriusFormattedString::SetNameArgument(const FString& ArgumentName, const FName Value)
+{
+	SetStringArgument(ArgumentName, Value.ToString());
+}
+
+void USiriusFormattedString::SetBoolArgument(const FString& ArgumentName, const bool Value)
+{
+	// Same representation as the Boolean to String conversion used by the Format String node
+	SetStringArgument(ArgumentName, Value ? TEXT("true") : TEXT("false"));
+}
+
+bool USiriusFormattedString::BindArgumentToField(const FString& ArgumentName, UObject* Source, const FName FieldName)
+{
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+	INotifyFieldValueChanged* NotifySource = Cast<INotifyFieldValueChanged>(Source);
+	if (!NotifySource)
+	{
+		UE_LOG(LogSiriusUtilityNodes, Warning, TEXT("Can't bind argument '%s', %s doesn't implement field notifications."), *ArgumentName, *GetNameSafe(Source));
+		return false;
+	}
+
+	const UE::FieldNotification::FFieldId FieldId = NotifySource->GetFieldNotificationDescriptor().GetField(Source->GetClass(), FieldName);
+	if (!FieldId.IsValid())
+	{
+		UE_LOG(LogSiriusUtilityNodes, Warning, TEXT("Can't bind argument '%s', %s is not a field notification of %s."), *ArgumentName, *FieldName.ToString(), *GetNameSafe(Source));
+		return false;
+	}
+
+	const FDelegateHandle Handle = NotifySource->AddFieldValueChangedDelegate(FieldId, INotifyFieldValueChanged::FFieldValueChangedDelegate::CreateWeakLambda(this, [this, ArgumentName, FieldName](const UObject* ChangedObject, UE::FieldNotification::FFieldId)
+	{
+		UpdateArgumentFromField(ArgumentName, ChangedObject, FieldName);
+	}));
+
+	FieldBindings.Add({Source, FieldName, Handle});
+
+	// Start out with the current value
+	UpdateArgumentFromField(ArgumentName, Source, FieldName);
+	return true;
+#else
+	UE_LOG(LogSiriusUtilityNodes, Warning, TEXT("Can't bind argument '%s', field notifications require UE 5.1 or later."), *ArgumentName);
+	return false;
+#endif
+}
+
+void USiriusFormattedString::UnbindAllFields()
+{
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+	for (const FFieldBinding& Binding : FieldBindings)
+	{
+		if (INotifyFieldValueChanged* NotifySource = Cast<INotifyFieldValueChanged>(Binding.Source.Get()))
+		{
+			const UE::FieldNotification::FFieldId FieldId = NotifySource->GetFieldNotificationDescriptor().GetField(Binding.Source->GetClass(), Binding.FieldName);
+			NotifySource->RemoveFieldValueChangedDelegate(FieldId, Binding.Handle);
+		}
+	}
+#endif
+	FieldBindings.Reset();
+}
+
+void USiriusFormattedString::SetArgument(const FSiriusStringFormatArgument& InArgument)
+{
+	FSiriusStringFormatArgument* ExistingArgument = Arguments.FindByPredicate([&InArgument](const FSiriusStringFormatArgument& Argument)
+	{
+		return Argument.ArgumentName.Equals(InArgument.ArgumentName, ESearchCase::CaseSensitive);
+	});
+
+	if (!ExistingArgument)
+	{
+		Arguments.Add(InArgument);
+		MarkDirty();
+	}
+	else if (*ExistingArgument != InArgument)
+	{
+		*ExistingArgument = InArgument;
+		MarkDirty();
+	}
+}
+
+void USiriusFormattedString::UpdateArgumentFromField(const FString& ArgumentName, const UObject* Source, const FName FieldName)
+{
+	if (!Source)
+	{
+		return;
+	}
+
+	const FProperty* Property = FindFProperty<FProperty>(Source->GetClass(), FieldName);
+	if (!Property)
+	{
+		return;
+	}
+
+	const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Source);
+	if (const FIntProperty* IntProperty = CastField<FIntProperty>(Property))
+	{
+		SetIntArgument(ArgumentName, IntProperty->GetPropertyValue(ValuePtr));
+	}
+	else if (const FInt64Property* Int64Property = CastField<FInt64Property>(Property))
+	{
+		SetInt64Argument(ArgumentName, Int64Property->GetPropertyValue(ValuePtr));
+	}
+	else if (const FFloatProperty* FloatProperty = CastField<FFloatProperty>(Property))
+	{
+		SetFloatArgument(ArgumentName, FloatProperty->GetPropertyValue(ValuePtr));
+	}
+	else if (const FDoubleProperty* DoubleProperty = CastField<FDoubleProperty>(Property))
+	{
+		SetDoubleArgument(ArgumentName, DoubleProperty->GetPropertyValue(ValuePtr));
+	}
+	else if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+	{
+		SetStringArgument(ArgumentName, StrProperty->GetPropertyValue(ValuePtr));
+	}
+	else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+	{
+		SetTextArgument(ArgumentName, TextProperty->GetPropertyValue(ValuePtr));
+	}
+	else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+	{
+		SetNameArgument(ArgumentName, NameProperty->GetPropertyValue(ValuePtr));
+	}
+	else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+	{
+		SetBoolArgument(ArgumentName, BoolProperty->GetPropertyValue(ValuePtr));
+	}
+	else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		const int64 Value = EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr);
+		SetStringArgument(ArgumentName, EnumProperty->GetEnum()->GetDisplayNameTextByValue(Value).ToString());
+	}
+	else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+	{
+		const uint8 Value = ByteProperty->GetPropertyValue(ValuePtr);
+		if (ByteProperty->Enum)
+		{
+			SetStringArgument(ArgumentName, ByteProperty->Enum->GetDisplayNameTextByValue(Value).ToString());
+		}
+		else
+		{
+			SetIntArgument(ArgumentName, Value);
+		}
+	}
+	else
+	{
+		// Anything else uses its text export representation
+		FString Value;
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+		Property->ExportTextItem_Direct(Value, ValuePtr, nullptr, nullptr, PPF_None);
+#else
+		Property->ExportTextItem(Value, ValuePtr, nullptr, nullptr, PPF_None);
+#endif
+		SetStringArgument(ArgumentName, Value);
+	}
+}
+
+void USiriusFormattedString::MarkDirty()
+{
+	bDirty = true;
+
+	// Combine all changes made this frame into a single update
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &USiriusFormattedString::OnTick));
+	}
+}
+
+void USiriusFormattedString::UpdateString()
+{
+	bDirty = false;
+
+	FString NewString = Pattern.Format(Arguments);
+	if (!NewString.Equals(FormattedString, ESearchCase::CaseSensitive))
+	{
+		FormattedString = MoveTemp(NewString);
+		bPendingBroadcast = true;
+	}
+}
+
+bool USiriusFormattedString::OnTick(float /*DeltaTime*/)
+{
+	TickerHandle.Reset();
+
+	if (bDirty)
+	{
+		UpdateString();
+	}
+
+	if (bPendingBroadcast)
+	{
+		bPendingBroadcast = false;
+		OnChanged.Broadcast(FormattedString);
+	}
+
+	// Only registered again once something changes
+	return false;
+}
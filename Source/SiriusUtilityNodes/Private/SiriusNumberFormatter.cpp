@@ -0,0 +1,219 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusNumberFormatter.h"
+
+namespace SiriusNumberFormatter
+{
+	/** "00" to "99", so two digits are written per division */
+	static constexpr ANSICHAR DigitPairs[] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+
+	/** Enough for the digits of any uint64 */
+	static constexpr int32 MaxDigits = 20;
+
+	/** Writes the digits of a value backwards from the end of the buffer, returns the first digit */
+	static TCHAR* WriteDigits(uint64 Value, TCHAR* BufferEnd)
+	{
+		TCHAR* Digit = BufferEnd;
+		while (Value >= 100)
+		{
+			const uint64 Pair = (Value % 100) * 2;
+			Value /= 100;
+			*--Digit = DigitPairs[Pair + 1];
+			*--Digit = DigitPairs[Pair];
+		}
+		if (Value >= 10)
+		{
+			const uint64 Pair = Value * 2;
+			*--Digit = DigitPairs[Pair + 1];
+			*--Digit = DigitPairs[Pair];
+		}
+		else
+		{
+			*--Digit = static_cast<TCHAR>(TEXT('0') + Value);
+		}
+		return Digit;
+	}
+
+	static void AppendDigits(const uint64 Value, const bool bGrouped, FStringBuilderBase& Out)
+	{
+		TCHAR Buffer[MaxDigits];
+		TCHAR* const BufferEnd = Buffer + MaxDigits;
+		const TCHAR* Digit = WriteDigits(Value, BufferEnd);
+		const int32 NumDigits = static_cast<int32>(BufferEnd - Digit);
+
+		if (!bGrouped || NumDigits <= 3)
+		{
+			Out.Append(Digit, NumDigits);
+			return;
+		}
+
+		// The first group holds the digits that don't fill a whole group.
+		int32 GroupLen = NumDigits % 3 == 0 ? 3 : NumDigits % 3;
+		Out.Append(Digit, GroupLen);
+		for (Digit += GroupLen; Digit < BufferEnd; Digit += 3)
+		{
+			Out.AppendChar(TEXT(','));
+			Out.Append(Digit, 3);
+		}
+	}
+
+	/**
+	 * Appends a value with up to the given number of fraction digits (at most 3), trimming trailing zeros.
+	 * The sign is only appended if the value doesn't round to zero.
+	 */
+	static void AppendFixed(const double AbsValue, const bool bNegative, const int32 MaxFractionDigits, const bool bGrouped, FStringBuilderBase& Out)
+	{
+		static constexpr uint64 Scales[] = { 1, 10, 100, 1000 };
+		const uint64 Scale = Scales[MaxFractionDigits];
+
+		// Values that don't fit the scaled integer have no fraction digits worth printing anyway.
+		const double Scaled = FMath::RoundHalfFromZero(AbsValue * Scale);
+		if (Scaled >= 1.8e19)
+		{
+			TStringBuilder<512> Digits;
+			Digits.Appendf(TEXT("%.0f"), AbsValue);
+			if (bNegative)
+			{
+				Out.AppendChar(TEXT('-'));
+			}
+			if (!bGrouped)
+			{
+				Out.Append(Digits);
+				return;
+			}
+			const int32 NumDigits = Digits.Len();
+			const int32 GroupLen = NumDigits % 3 == 0 ? 3 : NumDigits % 3;
+			Out.Append(Digits.GetData(), GroupLen);
+			for (int32 Index = GroupLen; Index < NumDigits; Index += 3)
+			{
+				Out.AppendChar(TEXT(','));
+				Out.Append(Digits.GetData() + Index, 3);
+			}
+			return;
+		}
+
+		const uint64 ScaledInt = static_cast<uint64>(Scaled);
+		if (bNegative && ScaledInt != 0)
+		{
+			Out.AppendChar(TEXT('-'));
+		}
+		AppendDigits(ScaledInt / Scale, bGrouped, Out);
+
+		uint64 Fraction = ScaledInt % Scale;
+		if (Fraction == 0)
+		{
+			return;
+		}
+
+		int32 NumFractionDigits = MaxFractionDigits;
+		while (Fraction % 10 == 0)
+		{
+			Fraction /= 10;
+			--NumFractionDigits;
+		}
+
+		TCHAR Buffer[3];
+		TCHAR* const BufferEnd = Buffer + NumFractionDigits;
+		for (TCHAR* Digit = WriteDigits(Fraction, BufferEnd); Digit > Buffer;)
+		{
+			// Leading zeros of the fraction, e.g. the 0 of ".05"
+			*--Digit = TEXT('0');
+		}
+		Out.AppendChar(TEXT('.'));
+		Out.Append(Buffer, NumFractionDigits);
+	}
+
+	/** Appends a value divided by the largest power of the base it exceeds, followed by that power's unit */
+	static void AppendScaled(const double AbsValue, const bool bNegative, const double Base, const TCHAR* const* Units, const int32 NumUnits, FStringBuilderBase& Out)
+	{
+		int32 Unit = 0;
+		double Scaled = AbsValue;
+		while (Unit + 1 < NumUnits && Scaled >= Base)
+		{
+			Scaled /= Base;
+			++Unit;
+		}
+
+		// Rounding can reach the next unit, 999.96K is 1M rather than 1000K.
+		if (Unit + 1 < NumUnits && FMath::RoundHalfFromZero(Scaled * 10.0) >= Base * 10.0)
+		{
+			Scaled /= Base;
+			++Unit;
+		}
+
+		AppendFixed(Scaled, bNegative, 1, Unit + 1 == NumUnits, Out);
+		Out << Units[Unit];
+	}
+
+	static void AppendNumber(const double AbsValue, const bool bNegative, const bool bIsIntegral, const ESiriusStringFormatSpecifier Specifier, FStringBuilderBase& Out)
+	{
+		switch (Specifier)
+		{
+		case ESiriusStringFormatSpecifier::Grouped:
+			AppendFixed(AbsValue, bNegative, bIsIntegral ? 0 : 3, true, Out);
+			break;
+		case ESiriusStringFormatSpecifier::Compact:
+			{
+				static const TCHAR* const Units[] = { TEXT(""), TEXT("K"), TEXT("M"), TEXT("B"), TEXT("T") };
+				AppendScaled(AbsValue, bNegative, 1000.0, Units, UE_ARRAY_COUNT(Units), Out);
+				break;
+			}
+		case ESiriusStringFormatSpecifier::Bytes:
+			{
+				static const TCHAR* const Units[] = { TEXT(" B"), TEXT(" KiB"), TEXT(" MiB"), TEXT(" GiB"), TEXT(" TiB"), TEXT(" PiB"), TEXT(" EiB") };
+				if (AbsValue < 1024.0)
+				{
+					// Bytes are whole.
+					AppendFixed(AbsValue, bNegative, 0, false, Out);
+					Out << Units[0];
+				}
+				else
+				{
+					AppendScaled(AbsValue, bNegative, 1024.0, Units, UE_ARRAY_COUNT(Units), Out);
+				}
+				break;
+			}
+		default:
+			checkNoEntry();
+			break;
+		}
+	}
+}
+
+void FSiriusNumberFormatter::AppendInteger(const int64 Value, const ESiriusStringFormatSpecifier Specifier, FStringBuilderBase& Out)
+{
+	using namespace SiriusNumberFormatter;
+
+	// Computed in unsigned, as the magnitude of the lowest int64 doesn't fit an int64.
+	const uint64 Magnitude = Value < 0 ? 0 - static_cast<uint64>(Value) : static_cast<uint64>(Value);
+
+	// Grouping is exact for any integer, the other specifiers round anyway.
+	if (Specifier == ESiriusStringFormatSpecifier::Grouped)
+	{
+		if (Value < 0)
+		{
+			Out.AppendChar(TEXT('-'));
+		}
+		AppendDigits(Magnitude, true, Out);
+		return;
+	}
+	AppendNumber(static_cast<double>(Magnitude), Value < 0, true, Specifier, Out);
+}
+
+void FSiriusNumberFormatter::AppendReal(const double Value, const ESiriusStringFormatSpecifier Specifier, FStringBuilderBase& Out)
+{
+	using namespace SiriusNumberFormatter;
+
+	if (!FMath::IsFinite(Value))
+	{
+		Out.Appendf(TEXT("%f"), Value);
+		return;
+	}
+
+	AppendNumber(FMath::Abs(Value), Value < 0.0, false, Specifier, Out);
+}
@@ -0,0 +1,268 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusPatternTable.h"
+
+#include "SiriusUtilityNodes.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Async/MappedFileHandle.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+
+// The table is mapped as-is, so segments must have the same layout on every platform.
+static_assert(PLATFORM_LITTLE_ENDIAN, "The Sirius pattern table is stored in little endian.");
+static_assert(sizeof(FSiriusStringFormatSegment) == 24, "Changing FSiriusStringFormatSegment requires a new pattern table version.");
+
+FSiriusPatternTable& FSiriusPatternTable::Get()
+{
+	static FSiriusPatternTable Table;
+	return Table;
+}
+
+FSiriusPatternTable::~FSiriusPatternTable()
+{
+	Unload();
+}
+
+int64 FSiriusPatternTable::GetPatternId(const FStringView Pattern)
+{
+	// FNV-1a over the characters as 32-bit values, so the ID doesn't depend on the size of TCHAR.
+	uint64 Hash = 0xcbf29ce484222325ull;
+	for (const TCHAR Char : Pattern)
+	{
+		uint32 Value = static_cast<uint32>(Char);
+		for (int32 Byte = 0; Byte < 4; ++Byte)
+		{
+			Hash ^= Value & 0xFF;
+			Hash *= 0x100000001b3ull;
+			Value >>= 8;
+		}
+	}
+	return static_cast<int64>(Hash);
+}
+
+FString FSiriusPatternTable::GetDefaultFilename()
+{
+	return FPaths::ProjectContentDir() / TEXT("Sirius") / TEXT("PatternTable.bin");
+}
+
+void FSiriusPatternTable::Load(const FString& Filename)
+{
+	Unload();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*Filename))
+	{
+		return;
+	}
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+
+	MappedHandle.Reset(PlatformFile.OpenMapped(*Filename));
+	if (MappedHandle.IsValid())
+	{
+		MappedRegion.Reset(MappedHandle->MapRegion());
+	}
+
+	if (MappedRegion.IsValid())
+	{
+		Data = MappedRegion->GetMappedPtr();
+		Size = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(LoadedData, *Filename))
+	{
+		Data = LoadedData.GetData();
+		Size = LoadedData.Num();
+	}
+
+	if (!Data || Size < static_cast<int64>(sizeof(FHeader)))
+	{
+		Unload();
+		return;
+	}
+
+	const FHeader* Header = reinterpret_cast<const FHeader*>(Data);
+	const int64 ExpectedSize = sizeof(FHeader) + static_cast<int64>(Header->NumEntries) * sizeof(FEntry) + static_cast<int64>(Header->NumSegments) * sizeof(FSiriusStringFormatSegment);
+	if (Header->Magic != Magic || Header->Version != Version || Size < ExpectedSize || Header->NumEntries > static_cast<uint32>(MAX_int32))
+	{
+		UE_LOG(LogSiriusUtilityNodes, Warning, TEXT("Ignoring outdated or invalid pattern table %s, run the SiriusPatternTable commandlet to regenerate it."), *Filename);
+		Unload();
+		return;
+	}
+
+	const TConstArrayView<FEntry> EntryView(reinterpret_cast<const FEntry*>(Data + sizeof(FHeader)), Header->NumEntries);
+	const FSiriusStringFormatSegment* SegmentData = reinterpret_cast<const FSiriusStringFormatSegment*>(Data + sizeof(FHeader) + static_cast<int64>(Header->NumEntries) * sizeof(FEntry));
+	if (!AreEntriesValid(EntryView, SegmentData, Header->NumSegments))
+	{
+		UE_LOG(LogSiriusUtilityNodes, Warning, TEXT("Ignoring corrupt pattern table %s, run the SiriusPatternTable commandlet to regenerate it."), *Filename);
+		Unload();
+		return;
+	}
+
+	Entries = EntryView.GetData();
+	Segments = SegmentData;
+	NumEntries = EntryView.Num();
+
+	UE_LOG(LogSiriusUtilityNodes, Log, TEXT("Loaded %d pre-parsed patterns from %s"), NumEntries, *Filename);
+}
+
+bool FSiriusPatternTable::AreEntriesValid(const TConstArrayView<FEntry> InEntries, const FSiriusStringFormatSegment* InSegments, const uint32 InNumSegments)
+{
+	// Every range is checked once here, so Find and Format can trust the table without checks of their own.
+	for (int32 EntryIdx = 0; EntryIdx < InEntries.Num(); ++EntryIdx)
+	{
+		const FEntry& Entry = InEntries[EntryIdx];
+		if (Entry.FirstSegment > InNumSegments || Entry.NumSegments > InNumSegments - Entry.FirstSegment ||
+			Entry.PatternLength > static_cast<uint32>(MAX_int32) ||
+			(EntryIdx > 0 && InEntries[EntryIdx - 1].PatternId >= Entry.PatternId))
+		{
+			return false;
+		}
+
+		const TConstArrayView<FSiriusStringFormatSegment> EntrySegments(InSegments + Entry.FirstSegment, Entry.NumSegments);
+		if (!FSiriusStringFormatPattern::AreSegmentsValid(Entry.PatternLength, EntrySegments))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FSiriusPatternTable::Unload()
+{
+	Entries = nullptr;
+	Segments = nullptr;
+	NumEntries = 0;
+
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+	LoadedData.Empty();
+}
+
+TConstArrayView<FSiriusStringFormatSegment> FSiriusPatternTable::FindOrParse(const int64 PatternId, const FStringView Pattern, TArray<FSiriusStringFormatSegment>& LocalSegments)
+{
+	TConstArrayView<FSiriusStringFormatSegment> TableSegments = Find(PatternId, Pattern.Len());
+	if (TableSegments.Num() > 0 || Pattern.IsEmpty())
+	{
+		return TableSegments;
+	}
+
+	// Segments are followed without bounds checks, so those of a colliding pattern must never be used.
+	{
+		FReadScopeLock ReadLock(ParsedPatternsLock);
+		if (const FParsedPattern* ParsedPattern = ParsedPatterns.Find(PatternId))
+		{
+			if (ParsedPattern->PatternLength == Pattern.Len())
+			{
+				return ParsedPattern->Segments;
+			}
+			FSiriusStringFormatPattern::Parse(Pattern, LocalSegments);
+			return LocalSegments;
+		}
+	}
+
+	TArray<FSiriusStringFormatSegment> NewSegments;
+	FSiriusStringFormatPattern::Parse(Pattern, NewSegments);
+
+	FWriteScopeLock WriteLock(ParsedPatternsLock);
+	if (const FParsedPattern* ParsedPattern = ParsedPatterns.Find(PatternId))
+	{
+		// Another thread parsed a pattern with this ID in the meantime.
+		if (ParsedPattern->PatternLength == Pattern.Len())
+		{
+			return ParsedPattern->Segments;
+		}
+		LocalSegments = MoveTemp(NewSegments);
+		return LocalSegments;
+	}
+
+	FParsedPattern& NewPattern = ParsedPatterns.Add(PatternId);
+	NewPattern.PatternLength = Pattern.Len();
+	NewPattern.Segments = MoveTemp(NewSegments);
+	return NewPattern.Segments;
+}
+
+TConstArrayView<FSiriusStringFormatSegment> FSiriusPatternTable::Find(const int64 PatternId, const int32 PatternLength) const
+{
+	if (NumEntries == 0)
+	{
+		return TConstArrayView<FSiriusStringFormatSegment>();
+	}
+
+	const TConstArrayView<FEntry> EntryView(Entries, NumEntries);
+	const int32 Index = Algo::BinarySearchBy(EntryView, static_cast<uint64>(PatternId), &FEntry::PatternId);
+	if (Index == INDEX_NONE || EntryView[Index].PatternLength != static_cast<uint32>(PatternLength))
+	{
+		return TConstArrayView<FSiriusStringFormatSegment>();
+	}
+
+	return TConstArrayView<FSiriusStringFormatSegment>(Segments + EntryView[Index].FirstSegment, EntryView[Index].NumSegments);
+}
+
+#if WITH_EDITOR
+bool FSiriusPatternTable::Save(const FString& Filename, const TArray<FString>& Patterns)
+{
+	TArray<FEntry> NewEntries;
+	TArray<FSiriusStringFormatSegment> NewSegments;
+	TSet<int64> AddedPatternIds;
+
+	for (const FString& Pattern : Patterns)
+	{
+		// Segment offsets are stored in characters, which only match between platforms if there are no surrogate pairs.
+		const bool bHasSurrogates = Pattern.GetCharArray().ContainsByPredicate([](const TCHAR Char)
+		{
+			return static_cast<uint32>(Char) > 0xFFFF || (Char >= 0xD800 && Char <= 0xDFFF);
+		});
+
+		const int64 PatternId = GetPatternId(Pattern);
+		bool bAlreadyAdded = false;
+		AddedPatternIds.Add(PatternId, &bAlreadyAdded);
+		if (Pattern.IsEmpty() || bHasSurrogates || bAlreadyAdded)
+		{
+			continue;
+		}
+
+		TArray<FSiriusStringFormatSegment> PatternSegments;
+		FSiriusStringFormatPattern::Parse(Pattern, PatternSegments);
+
+		FEntry& Entry = NewEntries.AddZeroed_GetRef();
+		Entry.PatternId = static_cast<uint64>(PatternId);
+		Entry.PatternLength = Pattern.Len();
+		Entry.FirstSegment = NewSegments.Num();
+		Entry.NumSegments = PatternSegments.Num();
+
+		for (const FSiriusStringFormatSegment& Segment : PatternSegments)
+		{
+			// Zero the padding so the file is deterministic
+			FSiriusStringFormatSegment& NewSegment = NewSegments.AddZeroed_GetRef();
+			NewSegment.Type = Segment.Type;
+			NewSegment.Specifier = Segment.Specifier;
+			NewSegment.SpecifierWidth = Segment.SpecifierWidth;
+			NewSegment.Offset = Segment.Offset;
+			NewSegment.Length = Segment.Length;
+			NewSegment.NameOffset = Segment.NameOffset;
+			NewSegment.NameLength = Segment.NameLength;
+			NewSegment.NumChildren = Segment.NumChildren;
+		}
+	}
+
+	Algo::SortBy(NewEntries, &FEntry::PatternId);
+
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.NumEntries = NewEntries.Num();
+	Header.NumSegments = NewSegments.Num();
+
+	TArray<uint8> Data;
+	Data.Append(reinterpret_cast<const uint8*>(&Header), sizeof(FHeader));
+	Data.Append(reinterpret_cast<const uint8*>(NewEntries.GetData()), NewEntries.Num() * sizeof(FEntry));
+	Data.Append(reinterpret_cast<const uint8*>(NewSegments.GetData()), NewSegments.Num() * sizeof(FSiriusStringFormatSegment));
+
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+#endif
@@ -0,0 +1,431 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusPropertyFormatter.h"
+
+#include "Misc/ScopeRWLock.h"
+#include "UObject/Class.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+namespace SiriusPropertyFormatter
+{
+	/** The ways a value can be appended, resolved once per property rather than once per value */
+	enum class EValueKind : uint8
+	{
+		Unsupported,
+		Int,
+		Int64,
+		Float,
+		Double,
+		String,
+		Name,
+		Text,
+		Bool,
+		Byte,
+		Enum,
+		Object,
+		Struct,
+		Array,
+	};
+
+	static EValueKind GetValueKind(const FProperty* Property)
+	{
+		if (Property->IsA<FIntProperty>())
+		{
+			return EValueKind::Int;
+		}
+		if (Property->IsA<FInt64Property>())
+		{
+			return EValueKind::Int64;
+		}
+		if (Property->IsA<FFloatProperty>())
+		{
+			return EValueKind::Float;
+		}
+		if (Property->IsA<FDoubleProperty>())
+		{
+			return EValueKind::Double;
+		}
+		if (Property->IsA<FStrProperty>())
+		{
+			return EValueKind::String;
+		}
+		if (Property->IsA<FNameProperty>())
+		{
+			return EValueKind::Name;
+		}
+		if (Property->IsA<FTextProperty>())
+		{
+			return EValueKind::Text;
+		}
+		if (Property->IsA<FBoolProperty>())
+		{
+			return EValueKind::Bool;
+		}
+		if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+		{
+			return ByteProperty->Enum ? EValueKind::Enum : EValueKind::Byte;
+		}
+		if (Property->IsA<FEnumProperty>())
+		{
+			return EValueKind::Enum;
+		}
+		if (Property->IsA<FObjectPropertyBase>())
+		{
+			return EValueKind::Object;
+		}
+		if (Property->IsA<FStructProperty>())
+		{
+			return EValueKind::Struct;
+		}
+		if (Property->IsA<FArrayProperty>())
+		{
+			return EValueKind::Array;
+		}
+		return EValueKind::Unsupported;
+	}
+
+	using FAppendStructFunction = void (*)(const void* Value, FStringBuilderBase& Out);
+
+	/** Fast paths for core math types, in the representation of their ToString conversion nodes */
+	static void AppendVector(const void* Value, FStringBuilderBase& Out)
+	{
+		const FVector& Vector = *static_cast<const FVector*>(Value);
+		Out.Appendf(TEXT("X=%3.3f Y=%3.3f Z=%3.3f"), Vector.X, Vector.Y, Vector.Z);
+	}
+
+	static void AppendVector2D(const void* Value, FStringBuilderBase& Out)
+	{
+		const FVector2D& Vector = *static_cast<const FVector2D*>(Value);
+		Out.Appendf(TEXT("X=%3.3f Y=%3.3f"), Vector.X, Vector.Y);
+	}
+
+	static void AppendRotator(const void* Value, FStringBuilderBase& Out)
+	{
+		const FRotator& Rotator = *static_cast<const FRotator*>(Value);
+		Out.Appendf(TEXT("P=%f Y=%f R=%f"), Rotator.Pitch, Rotator.Yaw, Rotator.Roll);
+	}
+
+	static void AppendQuat(const void* Value, FStringBuilderBase& Out)
+	{
+		const FQuat& Quat = *static_cast<const FQuat*>(Value);
+		Out.Appendf(TEXT("X=%.9f Y=%.9f Z=%.9f W=%.9f"), Quat.X, Quat.Y, Quat.Z, Quat.W);
+	}
+
+	static void AppendTransform(const void* Value, FStringBuilderBase& Out)
+	{
+		const FTransform& Transform = *static_cast<const FTransform*>(Value);
+		const FVector Translation = Transform.GetTranslation();
+		const FRotator Rotation = Transform.Rotator();
+		const FVector Scale = Transform.GetScale3D();
+
+		Out << TEXT("Translation: ");
+		AppendVector(&Translation, Out);
+		Out << TEXT(" Rotation: ");
+		AppendRotator(&Rotation, Out);
+		Out << TEXT(" Scale ");
+		AppendVector(&Scale, Out);
+	}
+
+	static void AppendLinearColor(const void* Value, FStringBuilderBase& Out)
+	{
+		const FLinearColor& Color = *static_cast<const FLinearColor*>(Value);
+		Out.Appendf(TEXT("(R=%f,G=%f,B=%f,A=%f)"), Color.R, Color.G, Color.B, Color.A);
+	}
+
+	static void AppendColor(const void* Value, FStringBuilderBase& Out)
+	{
+		const FColor& Color = *static_cast<const FColor*>(Value);
+		Out.Appendf(TEXT("(R=%i,G=%i,B=%i,A=%i)"), Color.R, Color.G, Color.B, Color.A);
+	}
+
+	static FAppendStructFunction FindFastPath(const UScriptStruct* Struct)
+	{
+		static const TMap<const UScriptStruct*, FAppendStructFunction> FastPaths = {
+			{ TBaseStructure<FVector>::Get(), &AppendVector },
+			{ TBaseStructure<FVector2D>::Get(), &AppendVector2D },
+			{ TBaseStructure<FRotator>::Get(), &AppendRotator },
+			{ TBaseStructure<FQuat>::Get(), &AppendQuat },
+			{ TBaseStructure<FTransform>::Get(), &AppendTransform },
+			{ TBaseStructure<FLinearColor>::Get(), &AppendLinearColor },
+			{ TBaseStructure<FColor>::Get(), &AppendColor },
+		};
+
+		const FAppendStructFunction* FastPath = FastPaths.Find(Struct);
+		return FastPath ? *FastPath : nullptr;
+	}
+
+	static void AppendValue(EValueKind Kind, const FProperty* Property, const void* Value, FStringBuilderBase& Out);
+
+	/**
+	 * Appends struct values as "(Field=Value, ...)". The fields and how to append them are resolved once, when the
+	 * formatter is created, so formatting a struct doesn't need any reflection lookups.
+	 */
+	class FStructFormatter
+	{
+	public:
+		explicit FStructFormatter(const UScriptStruct* Struct)
+			: FastPath(FindFastPath(Struct))
+		{
+			if (FastPath)
+			{
+				return;
+			}
+
+			for (TFieldIterator<FProperty> It(Struct); It; ++It)
+			{
+				const FProperty* Property = *It;
+				const EValueKind Kind = GetValueKind(Property);
+				if (Kind != EValueKind::Unsupported)
+				{
+					Fields.Add({ Property, Kind, FString::Printf(TEXT("%s="), *Property->GetAuthoredName()) });
+				}
+			}
+		}
+
+		void Append(const void* StructValue, FStringBuilderBase& Out) const
+		{
+			if (FastPath)
+			{
+				FastPath(StructValue, Out);
+				return;
+			}
+
+			Out.AppendChar(TEXT('('));
+			bool bFirst = true;
+			for (const FFieldFormat& Field : Fields)
+			{
+				for (int32 ArrayIndex = 0; ArrayIndex < Field.Property->ArrayDim; ++ArrayIndex)
+				{
+					if (!bFirst)
+					{
+						Out << TEXT(", ");
+					}
+					bFirst = false;
+
+					Out.Append(*Field.Prefix, Field.Prefix.Len());
+					AppendValue(Field.Kind, Field.Property, Field.Property->ContainerPtrToValuePtr<void>(StructValue, ArrayIndex), Out);
+				}
+			}
+			Out.AppendChar(TEXT(')'));
+		}
+
+	private:
+		struct FFieldFormat
+		{
+			const FProperty* Property;
+			EValueKind Kind;
+
+			/** "Name=", built once rather than for every value */
+			FString Prefix;
+		};
+
+		FAppendStructFunction FastPath;
+		TArray<FFieldFormat> Fields;
+	};
+
+	/** Formatters of native structs, created on first use. Formatting is thread safe, so is the cache. */
+	class FStructFormatterCache
+	{
+	public:
+		static FStructFormatterCache& Get()
+		{
+			static FStructFormatterCache Cache;
+			return Cache;
+		}
+
+		const FStructFormatter& FindOrAdd(const UScriptStruct* Struct)
+		{
+			{
+				FReadScopeLock ReadLock(Lock);
+				if (const TUniquePtr<FStructFormatter>* Formatter = Formatters.Find(Struct))
+				{
+					return **Formatter;
+				}
+			}
+
+			TUniquePtr<FStructFormatter> NewFormatter = MakeUnique<FStructFormatter>(Struct);
+
+			FWriteScopeLock WriteLock(Lock);
+			TUniquePtr<FStructFormatter>& Formatter = Formatters.FindOrAdd(Struct);
+			if (!Formatter)
+			{
+				Formatter = MoveTemp(NewFormatter);
+			}
+			return *Formatter;
+		}
+
+	private:
+		FRWLock Lock;
+		TMap<const UScriptStruct*, TUniquePtr<FStructFormatter>> Formatters;
+	};
+
+	/** Calls the function with the formatter of the struct, so it can be used for any number of values */
+	static void WithStructFormatter(const UScriptStruct* Struct, const TFunctionRef<void(const FStructFormatter&)> Function)
+	{
+		// Blueprint structs change layout when they are edited and may be unloaded, so only native structs, which live as
+		// long as their module, are cached by address.
+		if (!(Struct->StructFlags & STRUCT_Native))
+		{
+			Function(FStructFormatter(Struct));
+			return;
+		}
+		Function(FStructFormatterCache::Get().FindOrAdd(Struct));
+	}
+
+	static void AppendStruct(const UScriptStruct* Struct, const void* StructValue, FStringBuilderBase& Out)
+	{
+		WithStructFormatter(Struct, [StructValue, &Out](const FStructFormatter& Formatter)
+		{
+			Formatter.Append(StructValue, Out);
+		});
+	}
+
+	static const UEnum* GetEnum(const FProperty* Property)
+	{
+		if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+		{
+			return ByteProperty->Enum;
+		}
+		return CastFieldChecked<FEnumProperty>(Property)->GetEnum();
+	}
+
+	static int64 GetEnumValue(const FProperty* Property, const void* Value)
+	{
+		if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			return EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value);
+		}
+		return *static_cast<const uint8*>(Value);
+	}
+
+	static void AppendValue(const EValueKind Kind, const FProperty* Property, const void* Value, FStringBuilderBase& Out)
+	{
+		switch (Kind)
+		{
+		case EValueKind::Int:
+			Out.Appendf(TEXT("%d"), *static_cast<const int32*>(Value));
+			break;
+		case EValueKind::Int64:
+			Out.Appendf(TEXT("%lld"), *static_cast<const int64*>(Value));
+			break;
+		case EValueKind::Float:
+			Out.Appendf(TEXT("%f"), static_cast<double>(*static_cast<const float*>(Value)));
+			break;
+		case EValueKind::Double:
+			Out.Appendf(TEXT("%f"), *static_cast<const double*>(Value));
+			break;
+		case EValueKind::String:
+			{
+				const FString& String = *static_cast<const FString*>(Value);
+				Out.Append(*String, String.Len());
+			}
+			break;
+		case EValueKind::Name:
+			static_cast<const FName*>(Value)->AppendString(Out);
+			break;
+		case EValueKind::Text:
+			{
+				const FString& String = static_cast<const FText*>(Value)->ToString();
+				Out.Append(*String, String.Len());
+			}
+			break;
+		case EValueKind::Bool:
+			Out << (CastFieldChecked<FBoolProperty>(Property)->GetPropertyValue(Value) ? TEXT("true") : TEXT("false"));
+			break;
+		case EValueKind::Byte:
+			Out.Appendf(TEXT("%d"), static_cast<int32>(*static_cast<const uint8*>(Value)));
+			break;
+		case EValueKind::Enum:
+			{
+				const FString DisplayName = GetEnum(Property)->GetDisplayNameTextByValue(GetEnumValue(Property, Value)).ToString();
+				Out.Append(*DisplayName, DisplayName.Len());
+			}
+			break;
+		case EValueKind::Object:
+			{
+				const UObject* Object = CastFieldChecked<FObjectPropertyBase>(Property)->GetObjectPropertyValue(Value);
+				if (Object)
+				{
+					Object->GetFName().AppendString(Out);
+				}
+				else
+				{
+					Out << TEXT("None");
+				}
+			}
+			break;
+		case EValueKind::Struct:
+			AppendStruct(CastFieldChecked<FStructProperty>(Property)->Struct, Value, Out);
+			break;
+		case EValueKind::Array:
+			Out.AppendChar(TEXT('['));
+			FSiriusPropertyFormatter::AppendArray(CastFieldChecked<FArrayProperty>(Property), Value, TEXTVIEW(", "), 0, Out);
+			Out.AppendChar(TEXT(']'));
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void FSiriusPropertyFormatter::AppendValue(const FProperty* Property, const void* Value, FStringBuilderBase& Out)
+{
+	using namespace SiriusPropertyFormatter;
+
+	AppendValue(GetValueKind(Property), Property, Value, Out);
+}
+
+void FSiriusPropertyFormatter::AppendStruct(const UScriptStruct* Struct, const void* StructValue, FStringBuilderBase& Out)
+{
+	SiriusPropertyFormatter::AppendStruct(Struct, StructValue, Out);
+}
+
+void FSiriusPropertyFormatter::AppendArray(const FArrayProperty* ArrayProperty, const void* ArrayValue, const FStringView Separator, const int32 MaxElements, FStringBuilderBase& Out)
+{
+	using namespace SiriusPropertyFormatter;
+
+	FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayValue);
+	const int32 NumElements = ArrayHelper.Num();
+	const int32 NumAppended = MaxElements > 0 ? FMath::Min(NumElements, MaxElements) : NumElements;
+
+	const FProperty* ElementProperty = ArrayProperty->Inner;
+	const EValueKind ElementKind = GetValueKind(ElementProperty);
+
+	if (ElementKind == EValueKind::Struct)
+	{
+		// Look up the formatter once for all elements
+		WithStructFormatter(CastFieldChecked<FStructProperty>(ElementProperty)->Struct, [&](const FStructFormatter& Formatter)
+		{
+			for (int32 Index = 0; Index < NumAppended; ++Index)
+			{
+				if (Index > 0)
+				{
+					Out.Append(Separator.GetData(), Separator.Len());
+				}
+				Formatter.Append(ArrayHelper.GetRawPtr(Index), Out);
+			}
+		});
+	}
+	else
+	{
+		for (int32 Index = 0; Index < NumAppended; ++Index)
+		{
+			if (Index > 0)
+			{
+				Out.Append(Separator.GetData(), Separator.Len());
+			}
+			AppendValue(ElementKind, ElementProperty, ArrayHelper.GetRawPtr(Index), Out);
+		}
+	}
+
+	if (NumAppended < NumElements)
+	{
+		if (NumAppended > 0)
+		{
+			Out.Append(Separator.GetData(), Separator.Len());
+		}
+		Out.Appendf(TEXT("... (%d more)"), NumElements - NumAppended);
+	}
+}
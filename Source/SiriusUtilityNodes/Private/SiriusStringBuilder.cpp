@@ -0,0 +1,53 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusStringBuilder.h"
+
+#include "SiriusPatternTable.h"
+#include "SiriusStringFormatPattern.h"
+#include "SiriusStringLibrary.h"
+
+void USiriusStringBuilderLibrary::Append(FSiriusStringBuilder& Builder, const FString& InString)
+{
+	Builder.Buffer.Append(InString);
+}
+
+void USiriusStringBuilderLibrary::Reserve(FSiriusStringBuilder& Builder, const int32 NumChars)
+{
+	if (NumChars > Builder.Buffer.Len())
+	{
+		Builder.Buffer.Reserve(NumChars);
+	}
+}
+
+void USiriusStringBuilderLibrary::Reset(FSiriusStringBuilder& Builder)
+{
+	Builder.Buffer.Reset();
+}
+
+int32 USiriusStringBuilderLibrary::Len(const FSiriusStringBuilder& Builder)
+{
+	return Builder.Buffer.Len();
+}
+
+FString USiriusStringBuilderLibrary::Conv_StringBuilderToString(const FSiriusStringBuilder& Builder)
+{
+	return Builder.Buffer;
+}
+
+void USiriusStringBuilderLibrary::AppendFormatted(FSiriusStringBuilder& Builder, const int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs)
+{
+	// Linked patterns change at runtime, only literal ones are worth keeping around parsed.
+	TArray<FSiriusStringFormatSegment> ParsedSegments;
+	TConstArrayView<FSiriusStringFormatSegment> Segments;
+	if (PatternId != 0)
+	{
+		Segments = FSiriusPatternTable::Get().FindOrParse(PatternId, InPattern, ParsedSegments);
+	}
+	else
+	{
+		FSiriusStringFormatPattern::Parse(InPattern, ParsedSegments);
+		Segments = ParsedSegments;
+	}
+
+	FSiriusStringFormatPattern::Format(InPattern, Segments, InArgs, Builder.Buffer);
+}
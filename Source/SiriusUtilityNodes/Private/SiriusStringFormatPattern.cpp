@@ -0,0 +1,850 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusStringFormatPattern.h"
+
+#include "SiriusEncoding.h"
+#include "SiriusNumberFormatter.h"
+#include "SiriusStringLibrary.h"
+#include "SiriusStringSearch.h"
+
+namespace SiriusStringFormatPattern
+{
+	static constexpr TCHAR EscapeChar = TEXT('`');
+	static constexpr TCHAR OpenBracketChar = TEXT('{');
+	static constexpr TCHAR CloseBracketChar = TEXT('}');
+	static constexpr TCHAR SpecifierChar = TEXT(':');
+	static constexpr TCHAR FunctionChar = TEXT('|');
+	static constexpr TCHAR ChoicesOpenChar = TEXT('(');
+	static constexpr TCHAR ChoicesCloseChar = TEXT(')');
+	static constexpr TCHAR ChoiceSeparatorChar = TEXT(',');
+	static constexpr TCHAR ChoiceKeyChar = TEXT('=');
+
+	static bool IsEscapable(const TCHAR Char)
+	{
+		return Char == OpenBracketChar || Char == CloseBracketChar || Char == EscapeChar;
+	}
+
+	/** The text of a choice also ends at a separator or the closing parenthesis, so those can be escaped too */
+	static bool IsEscapableInChoice(const TCHAR Char)
+	{
+		return IsEscapable(Char) || Char == ChoiceSeparatorChar || Char == ChoicesCloseChar;
+	}
+
+	static void AddLiteral(TArray<FSiriusStringFormatSegment>& OutSegments, const int32 Start, const int32 End)
+	{
+		if (End > Start)
+		{
+			FSiriusStringFormatSegment& Segment = OutSegments.AddDefaulted_GetRef();
+			Segment.Type = ESiriusStringFormatSegmentType::Literal;
+			Segment.Offset = Start;
+			Segment.Length = End - Start;
+		}
+	}
+
+	static void AppendEncodedBytes(const TConstArrayView<uint8> Bytes, const ESiriusStringFormatSpecifier Specifier, FStringBuilderBase& Out)
+	{
+		switch (Specifier)
+		{
+		case ESiriusStringFormatSpecifier::Hex:
+		case ESiriusStringFormatSpecifier::HexUpperCase:
+			FSiriusEncoding::AppendHex(Bytes, Specifier == ESiriusStringFormatSpecifier::HexUpperCase, Out);
+			break;
+		case ESiriusStringFormatSpecifier::Bits:
+			FSiriusEncoding::AppendBinary(Bytes, Out);
+			break;
+		default:
+			FSiriusEncoding::AppendBase64(Bytes, Out);
+			break;
+		}
+	}
+
+	/** Appends an argument using one of the encoding specifiers, returns false if the specifier doesn't apply to its type */
+	static bool AppendEncodedArgument(const FSiriusStringFormatArgument& Arg, const ESiriusStringFormatSpecifier Specifier, const int32 Width, FStringBuilderBase& Out)
+	{
+		uint64 Bits = 0;
+		switch (Arg.ArgumentValueType)
+		{
+		case ESiriusStringFormatArgumentType::Int:
+			// The bits of the 32-bit value, so -1 is ffffffff rather than 16 digits.
+			Bits = static_cast<uint32>(Arg.ArgumentValueInt);
+			break;
+		case ESiriusStringFormatArgumentType::Int64:
+			Bits = static_cast<uint64>(Arg.ArgumentValueInt64);
+			break;
+		case ESiriusStringFormatArgumentType::String:
+			{
+				const FTCHARToUTF8 Utf8(*Arg.ArgumentValue, Arg.ArgumentValue.Len());
+				AppendEncodedBytes(TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), Specifier, Out);
+				return true;
+			}
+		case ESiriusStringFormatArgumentType::Bytes:
+			AppendEncodedBytes(Arg.ArgumentValueBytes, Specifier, Out);
+			return true;
+		default:
+			return false;
+		}
+
+		switch (Specifier)
+		{
+		case ESiriusStringFormatSpecifier::Hex:
+		case ESiriusStringFormatSpecifier::HexUpperCase:
+			FSiriusEncoding::AppendHex(Bits, Width, Specifier == ESiriusStringFormatSpecifier::HexUpperCase, Out);
+			return true;
+		case ESiriusStringFormatSpecifier::Bits:
+			FSiriusEncoding::AppendBinary(Bits, Width, Out);
+			return true;
+		default:
+			// Base64 is only meant for strings.
+			return false;
+		}
+	}
+
+	/** Returns true if the argument is formatted from its ArgumentValue text */
+	static bool IsText(const FSiriusStringFormatArgument& Arg)
+	{
+		return Arg.ArgumentValueType == ESiriusStringFormatArgumentType::String || Arg.ArgumentValueType == ESiriusStringFormatArgumentType::Bytes;
+	}
+
+	static int32 ParseArgument(FStringView Pattern, int32 Start, TArray<FSiriusStringFormatSegment>& OutSegments);
+
+	/**
+	 * Parses the text of a choice, which can contain arguments itself, appending its segments.
+	 * Returns the index of the separator or closing parenthesis ending it, or INDEX_NONE if it doesn't end before the argument does.
+	 */
+	static int32 ParseChoiceText(const FStringView Pattern, const int32 Start, TArray<FSiriusStringFormatSegment>& OutSegments)
+	{
+		const TCHAR* Chars = Pattern.GetData();
+		const int32 Len = Pattern.Len();
+
+		int32 LiteralStart = Start;
+		int32 Index = Start;
+		while (Index < Len)
+		{
+			const TCHAR Char = Chars[Index];
+			if (Char == EscapeChar && Index + 1 < Len && IsEscapableInChoice(Chars[Index + 1]))
+			{
+				AddLiteral(OutSegments, LiteralStart, Index);
+				LiteralStart = Index + 1;
+				Index += 2;
+			}
+			else if (Char == OpenBracketChar)
+			{
+				const int32 NumSegments = OutSegments.Num();
+				AddLiteral(OutSegments, LiteralStart, Index);
+				if (const int32 ArgumentLength = ParseArgument(Pattern, Index, OutSegments))
+				{
+					Index += ArgumentLength;
+					LiteralStart = Index;
+				}
+				else
+				{
+					OutSegments.SetNum(NumSegments, false);
+					++Index;
+				}
+			}
+			else if (Char == ChoiceSeparatorChar || Char == ChoicesCloseChar)
+			{
+				AddLiteral(OutSegments, LiteralStart, Index);
+				return Index;
+			}
+			else if (Char == CloseBracketChar)
+			{
+				return INDEX_NONE;
+			}
+			else
+			{
+				++Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Parses "{ Name }", "{ Name : Specifier }" or "{ Name | Function(Choices) }" starting at the open bracket, appending its segments.
+	 * Returns the length of the argument, or 0 if it isn't a valid argument, in which case nothing is appended.
+	 */
+	static int32 ParseArgument(const FStringView Pattern, const int32 Start, TArray<FSiriusStringFormatSegment>& OutSegments)
+	{
+		const TCHAR* Chars = Pattern.GetData();
+		const int32 Len = Pattern.Len();
+		const int32 ArgumentIdx = OutSegments.Num();
+
+		int32 Index = Start + 1;
+		auto SkipWhitespace = [Chars, Len, &Index]()
+		{
+			while (Index < Len && FChar::IsWhitespace(Chars[Index]))
+			{
+				++Index;
+			}
+		};
+		auto Fail = [&OutSegments, ArgumentIdx]()
+		{
+			OutSegments.SetNum(ArgumentIdx, false);
+			return 0;
+		};
+		SkipWhitespace();
+
+		const int32 NameStart = Index;
+		while (Index < Len && !FChar::IsWhitespace(Chars[Index]) && Chars[Index] != CloseBracketChar && Chars[Index] != OpenBracketChar && Chars[Index] != SpecifierChar && Chars[Index] != FunctionChar)
+		{
+			++Index;
+		}
+		const int32 NameEnd = Index;
+		if (NameEnd == NameStart)
+		{
+			return Fail();
+		}
+		SkipWhitespace();
+
+		{
+			FSiriusStringFormatSegment& Argument = OutSegments.AddDefaulted_GetRef();
+			Argument.Type = ESiriusStringFormatSegmentType::Argument;
+			Argument.NameOffset = NameStart;
+			Argument.NameLength = NameEnd - NameStart;
+		}
+
+		if (Index < Len && Chars[Index] == SpecifierChar)
+		{
+			++Index;
+			SkipWhitespace();
+
+			const int32 SpecifierStart = Index;
+			while (Index < Len && FChar::IsAlnum(Chars[Index]))
+			{
+				++Index;
+			}
+
+			// Unknown specifiers don't make an argument, like any other invalid syntax.
+			ESiriusStringFormatSpecifier Specifier;
+			uint8 SpecifierWidth;
+			if (!FSiriusStringFormatPattern::ParseSpecifier(Pattern.Mid(SpecifierStart, Index - SpecifierStart), Specifier, SpecifierWidth))
+			{
+				return Fail();
+			}
+			OutSegments[ArgumentIdx].Specifier = Specifier;
+			OutSegments[ArgumentIdx].SpecifierWidth = SpecifierWidth;
+			SkipWhitespace();
+		}
+		else if (Index < Len && Chars[Index] == FunctionChar)
+		{
+			++Index;
+			SkipWhitespace();
+
+			const int32 FunctionStart = Index;
+			while (Index < Len && FChar::IsAlpha(Chars[Index]))
+			{
+				++Index;
+			}
+			const FStringView Function = Pattern.Mid(FunctionStart, Index - FunctionStart);
+
+			ESiriusStringFormatSegmentType Type;
+			if (Function.Equals(TEXT("plural"), ESearchCase::CaseSensitive))
+			{
+				Type = ESiriusStringFormatSegmentType::Plural;
+			}
+			else if (Function.Equals(TEXT("select"), ESearchCase::CaseSensitive))
+			{
+				Type = ESiriusStringFormatSegmentType::Select;
+			}
+			else if (Function.Equals(TEXT("if"), ESearchCase::CaseSensitive))
+			{
+				Type = ESiriusStringFormatSegmentType::Conditional;
+			}
+			else
+			{
+				return Fail();
+			}
+			OutSegments[ArgumentIdx].Type = Type;
+
+			SkipWhitespace();
+			if (Index >= Len || Chars[Index] != ChoicesOpenChar)
+			{
+				return Fail();
+			}
+			++Index;
+
+			int32 NumChoices = 0;
+			while (true)
+			{
+				// Conditionals have no keys, their text is used exactly as written.
+				int32 KeyStart = Index;
+				int32 KeyEnd = Index;
+				if (Type != ESiriusStringFormatSegmentType::Conditional)
+				{
+					SkipWhitespace();
+					KeyStart = Index;
+					while (Index < Len && !FChar::IsWhitespace(Chars[Index]) && Chars[Index] != ChoiceKeyChar && Chars[Index] != ChoiceSeparatorChar
+						&& Chars[Index] != ChoicesCloseChar && Chars[Index] != OpenBracketChar && Chars[Index] != CloseBracketChar)
+					{
+						++Index;
+					}
+					KeyEnd = Index;
+					SkipWhitespace();
+
+					const FStringView Key = Pattern.Mid(KeyStart, KeyEnd - KeyStart);
+					const bool bIsValidKey = Type == ESiriusStringFormatSegmentType::Select
+						? !Key.IsEmpty()
+						: Key.Equals(TEXT("zero"), ESearchCase::CaseSensitive) || Key.Equals(TEXT("one"), ESearchCase::CaseSensitive) || Key.Equals(TEXT("other"), ESearchCase::CaseSensitive);
+					if (!bIsValidKey || Index >= Len || Chars[Index] != ChoiceKeyChar)
+					{
+						return Fail();
+					}
+					++Index;
+				}
+
+				const int32 ChoiceIdx = OutSegments.Num();
+				{
+					FSiriusStringFormatSegment& Choice = OutSegments.AddDefaulted_GetRef();
+					Choice.Type = ESiriusStringFormatSegmentType::Choice;
+					Choice.Offset = Index;
+					Choice.NameOffset = KeyStart;
+					Choice.NameLength = KeyEnd - KeyStart;
+				}
+
+				const int32 TextEnd = ParseChoiceText(Pattern, Index, OutSegments);
+				if (TextEnd == INDEX_NONE)
+				{
+					return Fail();
+				}
+				OutSegments[ChoiceIdx].Length = TextEnd - Index;
+				OutSegments[ChoiceIdx].NumChildren = OutSegments.Num() - ChoiceIdx - 1;
+				++NumChoices;
+
+				Index = TextEnd + 1;
+				if (Chars[TextEnd] == ChoicesCloseChar)
+				{
+					break;
+				}
+			}
+
+			// "if(Text)" or "if(Text,Otherwise)"
+			if (Type == ESiriusStringFormatSegmentType::Conditional && NumChoices > 2)
+			{
+				return Fail();
+			}
+			SkipWhitespace();
+		}
+
+		if (Index >= Len || Chars[Index] != CloseBracketChar)
+		{
+			return Fail();
+		}
+
+		FSiriusStringFormatSegment& Argument = OutSegments[ArgumentIdx];
+		Argument.Offset = Start;
+		Argument.Length = Index + 1 - Start;
+		Argument.NumChildren = OutSegments.Num() - ArgumentIdx - 1;
+		return Argument.Length;
+	}
+
+	static const FSiriusStringFormatArgument* FindArgument(const TConstArrayView<FSiriusStringFormatArgument> Args, const FStringView Name)
+	{
+		for (const FSiriusStringFormatArgument& Arg : Args)
+		{
+			if (Name.Equals(Arg.ArgumentName, ESearchCase::CaseSensitive))
+			{
+				return &Arg;
+			}
+		}
+
+		// FString::Format matches names case insensitively, keep doing so if there's no exact match.
+		for (const FSiriusStringFormatArgument& Arg : Args)
+		{
+			if (Name.Equals(Arg.ArgumentName, ESearchCase::IgnoreCase))
+			{
+				return &Arg;
+			}
+		}
+
+		return nullptr;
+	}
+
+	static bool IsEncodingSpecifier(const ESiriusStringFormatSpecifier Specifier)
+	{
+		return Specifier == ESiriusStringFormatSpecifier::Hex || Specifier == ESiriusStringFormatSpecifier::HexUpperCase
+			|| Specifier == ESiriusStringFormatSpecifier::Bits || Specifier == ESiriusStringFormatSpecifier::Base64;
+	}
+
+	static void AppendText(const FStringView Text, FStringBuilderBase& Out)
+	{
+		Out.Append(Text.GetData(), Text.Len());
+	}
+
+	static void AppendText(const FStringView Text, FUtf8StringBuilderBase& Out)
+	{
+		FSiriusEncoding::AppendUtf8(Text, Out);
+	}
+
+	static void AppendText(const FStringView Text, FString& Out)
+	{
+		Out.Append(Text.GetData(), Text.Len());
+	}
+
+	/** Returns true if a conditional with this argument formats its first choice */
+	static bool IsTruthy(const FSiriusStringFormatArgument& Arg)
+	{
+		switch (Arg.ArgumentValueType)
+		{
+		case ESiriusStringFormatArgumentType::Int:
+			return Arg.ArgumentValueInt != 0;
+		case ESiriusStringFormatArgumentType::Int64:
+			return Arg.ArgumentValueInt64 != 0;
+		case ESiriusStringFormatArgumentType::Float:
+			return Arg.ArgumentValueFloat != 0.0f;
+		case ESiriusStringFormatArgumentType::Double:
+			return Arg.ArgumentValueDouble != 0.0;
+		case ESiriusStringFormatArgumentType::String:
+		case ESiriusStringFormatArgumentType::Bytes:
+			// Booleans are passed as "true" or "false", objects that aren't set as "None".
+			return !Arg.ArgumentValue.IsEmpty()
+				&& !Arg.ArgumentValue.Equals(TEXT("false"), ESearchCase::IgnoreCase)
+				&& !Arg.ArgumentValue.Equals(TEXT("0"), ESearchCase::CaseSensitive)
+				&& !Arg.ArgumentValue.Equals(TEXT("None"), ESearchCase::CaseSensitive);
+		default:
+			return false;
+		}
+	}
+
+	/** Returns the plural category of the argument's value, numbers in strings are converted */
+	static const TCHAR* GetPluralKey(const FSiriusStringFormatArgument& Arg)
+	{
+		double Value;
+		switch (Arg.ArgumentValueType)
+		{
+		case ESiriusStringFormatArgumentType::Int:
+			Value = Arg.ArgumentValueInt;
+			break;
+		case ESiriusStringFormatArgumentType::Int64:
+			Value = static_cast<double>(Arg.ArgumentValueInt64);
+			break;
+		case ESiriusStringFormatArgumentType::Float:
+			Value = Arg.ArgumentValueFloat;
+			break;
+		case ESiriusStringFormatArgumentType::Double:
+			Value = Arg.ArgumentValueDouble;
+			break;
+		case ESiriusStringFormatArgumentType::String:
+		case ESiriusStringFormatArgumentType::Bytes:
+			if (!FCString::IsNumeric(*Arg.ArgumentValue))
+			{
+				return TEXT("other");
+			}
+			Value = FCString::Atod(*Arg.ArgumentValue);
+			break;
+		default:
+			return TEXT("other");
+		}
+
+		// The same rules for every culture: only exactly 1 is singular.
+		if (Value == 0.0)
+		{
+			return TEXT("zero");
+		}
+		return FMath::Abs(Value) == 1.0 ? TEXT("one") : TEXT("other");
+	}
+
+	/** Returns the index of the choice of a plural, select or conditional segment to format, or INDEX_NONE to format nothing */
+	static int32 FindChoice(const FStringView InPattern, const TConstArrayView<FSiriusStringFormatSegment> InSegments, const int32 SegmentIdx, const FSiriusStringFormatArgument& Arg)
+	{
+		const FSiriusStringFormatSegment& Segment = InSegments[SegmentIdx];
+		const int32 End = SegmentIdx + 1 + Segment.NumChildren;
+
+		auto FindKey = [InPattern, InSegments, SegmentIdx, End](const FStringView Key)
+		{
+			for (int32 ChoiceIdx = SegmentIdx + 1; ChoiceIdx < End; ChoiceIdx += 1 + InSegments[ChoiceIdx].NumChildren)
+			{
+				const FSiriusStringFormatSegment& Choice = InSegments[ChoiceIdx];
+				if (InPattern.Mid(Choice.NameOffset, Choice.NameLength).Equals(Key, ESearchCase::CaseSensitive))
+				{
+					return ChoiceIdx;
+				}
+			}
+			return static_cast<int32>(INDEX_NONE);
+		};
+
+		int32 ChoiceIdx = INDEX_NONE;
+		switch (Segment.Type)
+		{
+		case ESiriusStringFormatSegmentType::Conditional:
+			{
+				const int32 FirstIdx = SegmentIdx + 1;
+				const int32 SecondIdx = FirstIdx + 1 + InSegments[FirstIdx].NumChildren;
+				if (IsTruthy(Arg))
+				{
+					return FirstIdx;
+				}
+				return SecondIdx < End ? SecondIdx : INDEX_NONE;
+			}
+		case ESiriusStringFormatSegmentType::Plural:
+			ChoiceIdx = FindKey(GetPluralKey(Arg));
+			break;
+		case ESiriusStringFormatSegmentType::Select:
+			{
+				TStringBuilder<128> Value;
+				FSiriusStringFormatPattern::AppendArgument(Arg, Value);
+				ChoiceIdx = FindKey(Value.ToView());
+				break;
+			}
+		default:
+			checkNoEntry();
+			break;
+		}
+
+		// "zero" falls back to "other" too, so it is only needed where it differs.
+		return ChoiceIdx != INDEX_NONE ? ChoiceIdx : FindKey(TEXT("other"));
+	}
+
+	/** Segments nest no deeper than this in valid patterns, which bounds the recursion of IsRangeValid */
+	static constexpr int32 MaxValidDepth = 64;
+
+	static bool IsTextRangeValid(const int32 PatternLength, const int32 Offset, const int32 Length)
+	{
+		return Offset >= 0 && Length >= 0 && Offset <= PatternLength && Length <= PatternLength - Offset;
+	}
+
+	/** Checks the segments in the range and their children, bChoices is true for the children of a plural, select or conditional segment */
+	static bool IsRangeValid(const int32 PatternLength, const TConstArrayView<FSiriusStringFormatSegment> InSegments, const int32 Begin, const int32 End, const bool bChoices, const int32 Depth)
+	{
+		if (Depth > MaxValidDepth)
+		{
+			return false;
+		}
+
+		for (int32 SegmentIdx = Begin; SegmentIdx < End;)
+		{
+			const FSiriusStringFormatSegment& Segment = InSegments[SegmentIdx];
+			if (Segment.Type > ESiriusStringFormatSegmentType::Choice ||
+				Segment.Specifier > ESiriusStringFormatSpecifier::Base64 ||
+				!IsTextRangeValid(PatternLength, Segment.Offset, Segment.Length) ||
+				!IsTextRangeValid(PatternLength, Segment.NameOffset, Segment.NameLength) ||
+				Segment.NumChildren < 0 || Segment.NumChildren >= End - SegmentIdx)
+			{
+				return false;
+			}
+
+			const int32 ChildrenBegin = SegmentIdx + 1;
+			const int32 ChildrenEnd = ChildrenBegin + Segment.NumChildren;
+			switch (Segment.Type)
+			{
+			case ESiriusStringFormatSegmentType::Literal:
+			case ESiriusStringFormatSegmentType::Argument:
+				if (bChoices || Segment.NumChildren != 0)
+				{
+					return false;
+				}
+				break;
+			case ESiriusStringFormatSegmentType::Plural:
+			case ESiriusStringFormatSegmentType::Select:
+			case ESiriusStringFormatSegmentType::Conditional:
+				// A conditional reads its first choice without checking there is one.
+				if (bChoices || (Segment.Type == ESiriusStringFormatSegmentType::Conditional && Segment.NumChildren == 0) ||
+					!IsRangeValid(PatternLength, InSegments, ChildrenBegin, ChildrenEnd, true, Depth + 1))
+				{
+					return false;
+				}
+				break;
+			case ESiriusStringFormatSegmentType::Choice:
+				if (!bChoices || !IsRangeValid(PatternLength, InSegments, ChildrenBegin, ChildrenEnd, false, Depth + 1))
+				{
+					return false;
+				}
+				break;
+			}
+
+			SegmentIdx = ChildrenEnd;
+		}
+		return true;
+	}
+
+	/** Formats the segments in the range, shared by the overloads of Format which only differ in how text is appended */
+	template <typename BuilderType>
+	static void FormatSegments(const FStringView InPattern, const TConstArrayView<FSiriusStringFormatSegment> InSegments, const int32 Begin, const int32 End, const TConstArrayView<FSiriusStringFormatArgument> Args, BuilderType& Out)
+	{
+		const TCHAR* Chars = InPattern.GetData();
+		for (int32 SegmentIdx = Begin; SegmentIdx < End; SegmentIdx += 1 + InSegments[SegmentIdx].NumChildren)
+		{
+			const FSiriusStringFormatSegment& Segment = InSegments[SegmentIdx];
+			if (Segment.HasArgumentName())
+			{
+				if (const FSiriusStringFormatArgument* Arg = FindArgument(Args, FStringView(Chars + Segment.NameOffset, Segment.NameLength)))
+				{
+					if (Segment.Type == ESiriusStringFormatSegmentType::Argument)
+					{
+						FSiriusStringFormatPattern::AppendArgument(*Arg, Out, Segment.Specifier, Segment.SpecifierWidth);
+					}
+					else
+					{
+						// Arguments in the other choices are never formatted.
+						const int32 ChoiceIdx = FindChoice(InPattern, InSegments, SegmentIdx, *Arg);
+						if (ChoiceIdx != INDEX_NONE)
+						{
+							FormatSegments(InPattern, InSegments, ChoiceIdx + 1, ChoiceIdx + 1 + InSegments[ChoiceIdx].NumChildren, Args, Out);
+						}
+					}
+					continue;
+				}
+			}
+
+			// Literals, and arguments that weren't provided, are copied from the pattern.
+			AppendText(FStringView(Chars + Segment.Offset, Segment.Length), Out);
+		}
+	}
+}
+
+FSiriusStringFormatPattern::FSiriusStringFormatPattern(FString InPattern)
+	: Pattern(MoveTemp(InPattern))
+{
+	Parse(Pattern, Segments);
+}
+
+void FSiriusStringFormatPattern::GetArgumentNames(TArray<FString>& OutArgumentNames) const
+{
+	for (const FSiriusStringFormatSegment& Segment : Segments)
+	{
+		if (Segment.HasArgumentName())
+		{
+			const FStringView Name = FStringView(Pattern).Mid(Segment.NameOffset, Segment.NameLength);
+			if (!OutArgumentNames.ContainsByPredicate([Name](const FString& ExistingName) { return Name.Equals(ExistingName, ESearchCase::CaseSensitive); }))
+			{
+				OutArgumentNames.Emplace(Name);
+			}
+		}
+	}
+}
+
+void FSiriusStringFormatPattern::Format(const TConstArrayView<FSiriusStringFormatArgument> Args, FStringBuilderBase& Out) const
+{
+	Format(Pattern, Segments, Args, Out);
+}
+
+void FSiriusStringFormatPattern::Format(const TConstArrayView<FSiriusStringFormatArgument> Args, FUtf8StringBuilderBase& Out) const
+{
+	Format(Pattern, Segments, Args, Out);
+}
+
+FString FSiriusStringFormatPattern::Format(const TConstArrayView<FSiriusStringFormatArgument> Args) const
+{
+	TStringBuilder<256> Builder;
+	Format(Args, Builder);
+	return FString(Builder.ToView());
+}
+
+void FSiriusStringFormatPattern::Parse(const FStringView InPattern, TArray<FSiriusStringFormatSegment>& OutSegments)
+{
+	using namespace SiriusStringFormatPattern;
+
+	OutSegments.Reset();
+
+	const TCHAR* Chars = InPattern.GetData();
+	const int32 Len = InPattern.Len();
+
+	int32 LiteralStart = 0;
+	int32 Index = 0;
+	while (Index < Len)
+	{
+		// Only escapes and arguments end a literal, so skip to the next candidate 8 characters at a time.
+		Index = FSiriusStringSearch::FindFirstOf(InPattern, OpenBracketChar, EscapeChar, Index);
+		if (Index == INDEX_NONE)
+		{
+			break;
+		}
+
+		const TCHAR Char = Chars[Index];
+		if (Char == EscapeChar && Index + 1 < Len && IsEscapable(Chars[Index + 1]))
+		{
+			// Drop the escape character, the escaped character starts the next literal.
+			AddLiteral(OutSegments, LiteralStart, Index);
+			LiteralStart = Index + 1;
+			Index += 2;
+		}
+		else if (Char == OpenBracketChar)
+		{
+			const int32 NumSegments = OutSegments.Num();
+			AddLiteral(OutSegments, LiteralStart, Index);
+			if (const int32 ArgumentLength = ParseArgument(InPattern, Index, OutSegments))
+			{
+				Index += ArgumentLength;
+				LiteralStart = Index;
+			}
+			else
+			{
+				OutSegments.SetNum(NumSegments, false);
+				++Index;
+			}
+		}
+		else
+		{
+			++Index;
+		}
+	}
+
+	AddLiteral(OutSegments, LiteralStart, Len);
+}
+
+bool FSiriusStringFormatPattern::AreSegmentsValid(const int32 PatternLength, const TConstArrayView<FSiriusStringFormatSegment> InSegments)
+{
+	return SiriusStringFormatPattern::IsRangeValid(PatternLength, InSegments, 0, InSegments.Num(), false, 0);
+}
+
+void FSiriusStringFormatPattern::Format(const FStringView InPattern, const TConstArrayView<FSiriusStringFormatSegment> InSegments, const TConstArrayView<FSiriusStringFormatArgument> Args, FStringBuilderBase& Out)
+{
+	SiriusStringFormatPattern::FormatSegments(InPattern, InSegments, 0, InSegments.Num(), Args, Out);
+}
+
+void FSiriusStringFormatPattern::Format(const FStringView InPattern, const TConstArrayView<FSiriusStringFormatSegment> InSegments, const TConstArrayView<FSiriusStringFormatArgument> Args, FUtf8StringBuilderBase& Out)
+{
+	SiriusStringFormatPattern::FormatSegments(InPattern, InSegments, 0, InSegments.Num(), Args, Out);
+}
+
+void FSiriusStringFormatPattern::Format(const FStringView InPattern, const TConstArrayView<FSiriusStringFormatSegment> InSegments, const TConstArrayView<FSiriusStringFormatArgument> Args, FString& Out)
+{
+	SiriusStringFormatPattern::FormatSegments(InPattern, InSegments, 0, InSegments.Num(), Args, Out);
+}
+
+void FSiriusStringFormatPattern::AppendArgument(const FSiriusStringFormatArgument& Arg, FStringBuilderBase& Out, const ESiriusStringFormatSpecifier Specifier, const int32 SpecifierWidth)
+{
+	using namespace SiriusStringFormatPattern;
+
+	if (IsEncodingSpecifier(Specifier))
+	{
+		if (AppendEncodedArgument(Arg, Specifier, SpecifierWidth, Out))
+		{
+			return;
+		}
+	}
+	else if (Specifier != ESiriusStringFormatSpecifier::None)
+	{
+		switch (Arg.ArgumentValueType)
+		{
+		case ESiriusStringFormatArgumentType::Int:
+			FSiriusNumberFormatter::AppendInteger(Arg.ArgumentValueInt, Specifier, Out);
+			return;
+		case ESiriusStringFormatArgumentType::Int64:
+			FSiriusNumberFormatter::AppendInteger(Arg.ArgumentValueInt64, Specifier, Out);
+			return;
+		case ESiriusStringFormatArgumentType::Float:
+			FSiriusNumberFormatter::AppendReal(Arg.ArgumentValueFloat, Specifier, Out);
+			return;
+		case ESiriusStringFormatArgumentType::Double:
+			FSiriusNumberFormatter::AppendReal(Arg.ArgumentValueDouble, Specifier, Out);
+			return;
+		default:
+			// Specifiers only apply to numbers
+			break;
+		}
+	}
+
+	switch (Arg.ArgumentValueType)
+	{
+	case ESiriusStringFormatArgumentType::Int:
+		Out.Appendf(TEXT("%d"), Arg.ArgumentValueInt);
+		break;
+	case ESiriusStringFormatArgumentType::Int64:
+		Out.Appendf(TEXT("%lld"), Arg.ArgumentValueInt64);
+		break;
+	case ESiriusStringFormatArgumentType::Float:
+		Out.Appendf(TEXT("%f"), static_cast<double>(Arg.ArgumentValueFloat));
+		break;
+	case ESiriusStringFormatArgumentType::String:
+	case ESiriusStringFormatArgumentType::Bytes:
+		Out.Append(*Arg.ArgumentValue, Arg.ArgumentValue.Len());
+		break;
+	case ESiriusStringFormatArgumentType::Double:
+		Out.Appendf(TEXT("%f"), Arg.ArgumentValueDouble);
+		break;
+	default:
+		break;
+	}
+}
+
+void FSiriusStringFormatPattern::AppendArgument(const FSiriusStringFormatArgument& Arg, FUtf8StringBuilderBase& Out, const ESiriusStringFormatSpecifier Specifier, const int32 SpecifierWidth)
+{
+	using namespace SiriusStringFormatPattern;
+
+	// Strings are converted straight into the output, everything else is short and formatted on the stack first.
+	if (IsText(Arg) && !IsEncodingSpecifier(Specifier))
+	{
+		FSiriusEncoding::AppendUtf8(Arg.ArgumentValue, Out);
+		return;
+	}
+
+	TStringBuilder<128> Value;
+	AppendArgument(Arg, Value, Specifier, SpecifierWidth);
+	FSiriusEncoding::AppendUtf8(Value.ToView(), Out);
+}
+
+void FSiriusStringFormatPattern::AppendArgument(const FSiriusStringFormatArgument& Arg, FString& Out, const ESiriusStringFormatSpecifier Specifier, const int32 SpecifierWidth)
+{
+	using namespace SiriusStringFormatPattern;
+
+	// Strings are appended straight to the output, everything else is short and formatted on the stack first.
+	if (IsText(Arg) && !IsEncodingSpecifier(Specifier))
+	{
+		Out.Append(*Arg.ArgumentValue, Arg.ArgumentValue.Len());
+		return;
+	}
+
+	TStringBuilder<128> Value;
+	AppendArgument(Arg, Value, Specifier, SpecifierWidth);
+	Out.Append(Value.GetData(), Value.Len());
+}
+
+bool FSiriusStringFormatPattern::ParseSpecifier(const FStringView Text, ESiriusStringFormatSpecifier& OutSpecifier, uint8& OutWidth)
+{
+	struct FSpecifierName
+	{
+		const TCHAR* Name;
+		ESiriusStringFormatSpecifier Specifier;
+		bool bHasWidth;
+	};
+	static const FSpecifierName Names[] = {
+		{ TEXT("n"), ESiriusStringFormatSpecifier::Grouped, false },
+		{ TEXT("c"), ESiriusStringFormatSpecifier::Compact, false },
+		{ TEXT("b"), ESiriusStringFormatSpecifier::Bytes, false },
+		{ TEXT("x"), ESiriusStringFormatSpecifier::Hex, true },
+		{ TEXT("X"), ESiriusStringFormatSpecifier::HexUpperCase, true },
+		{ TEXT("bin"), ESiriusStringFormatSpecifier::Bits, true },
+		{ TEXT("b64"), ESiriusStringFormatSpecifier::Base64, false },
+	};
+
+	// Exact names first, "b64" is not "b" with a width.
+	for (const FSpecifierName& Name : Names)
+	{
+		if (Text.Equals(Name.Name, ESearchCase::CaseSensitive))
+		{
+			OutSpecifier = Name.Specifier;
+			OutWidth = 0;
+			return true;
+		}
+	}
+
+	for (const FSpecifierName& Name : Names)
+	{
+		const FStringView NameView(Name.Name);
+		if (!Name.bHasWidth || !Text.StartsWith(NameView, ESearchCase::CaseSensitive))
+		{
+			continue;
+		}
+
+		// Up to 64 digits, the width of an Int64 in binary.
+		int32 Width = 0;
+		const FStringView WidthText = Text.RightChop(NameView.Len());
+		for (const TCHAR Char : WidthText)
+		{
+			if (!FChar::IsDigit(Char) || Width > 64)
+			{
+				return false;
+			}
+			Width = Width * 10 + (Char - TEXT('0'));
+		}
+		if (Width < 1 || Width > 64)
+		{
+			return false;
+		}
+
+		OutSpecifier = Name.Specifier;
+		OutWidth = static_cast<uint8>(Width);
+		return true;
+	}
+	return false;
+}
@@ -2,8 +2,24 @@
 
 #include "SiriusStringLibrary.h"
 
+#include "SiriusDebugOutputSink.h"
+#include "SiriusEncoding.h"
+#include "SiriusFormatAsyncAction.h"
+#include "SiriusFormatNameCache.h"
+#include "SiriusFormatResultCache.h"
+#include "SiriusPatternTable.h"
+#include "SiriusPropertyFormatter.h"
+#include "SiriusStringFormatPattern.h"
+#include "SiriusStringScanner.h"
+#include "SiriusStringSearch.h"
+#include "SiriusUtilityNodes.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineLogs.h"
+#include "Kismet/KismetSystemLibrary.h"
 #include "Misc/StringFormatter.h"
 #include "UObject/EditorObjectVersion.h"
+#include "UObject/UnrealType.h"
 
 void FSiriusStringFormatArgument::ResetValue()
 {
@@ -13,6 +29,7 @@ void FSiriusStringFormatArgument::ResetValue()
 	ArgumentValueInt64 = 0;
 	ArgumentValueFloat = 0.0f;
 	ArgumentValueDouble = 0.0;
+	ArgumentValueBytes.Empty();
 }
 
 FStringFormatArg FSiriusStringFormatArgument::ToEngineFormatArg() const
@@ -26,6 +43,7 @@ FStringFormatArg FSiriusStringFormatArgument::ToEngineFormatArg() const
 	case ESiriusStringFormatArgumentType::Float:
 		return FStringFormatArg(ArgumentValueFloat);
 	case ESiriusStringFormatArgumentType::String:
+	case ESiriusStringFormatArgumentType::Bytes:
 		return FStringFormatArg(ArgumentValue);
 	case ESiriusStringFormatArgumentType::Double:
 		return FStringFormatArg(ArgumentValueDouble);
@@ -35,6 +53,59 @@ FStringFormatArg FSiriusStringFormatArgument::ToEngineFormatArg() const
 	return FStringFormatArg(TEXT(""));
 }
 
+bool FSiriusStringFormatArgument::operator==(const FSiriusStringFormatArgument& Other) const
+{
+	if (ArgumentValueType != Other.ArgumentValueType || !ArgumentName.Equals(Other.ArgumentName, ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	switch (ArgumentValueType)
+	{
+	case ESiriusStringFormatArgumentType::Int:
+		return ArgumentValueInt == Other.ArgumentValueInt;
+	case ESiriusStringFormatArgumentType::Int64:
+		return ArgumentValueInt64 == Other.ArgumentValueInt64;
+	// Compare the bits, -0 equals 0 but is formatted differently.
+	case ESiriusStringFormatArgumentType::Float:
+		return FMemory::Memcmp(&ArgumentValueFloat, &Other.ArgumentValueFloat, sizeof(float)) == 0;
+	case ESiriusStringFormatArgumentType::String:
+		return ArgumentValue.Equals(Other.ArgumentValue, ESearchCase::CaseSensitive);
+	case ESiriusStringFormatArgumentType::Double:
+		return FMemory::Memcmp(&ArgumentValueDouble, &Other.ArgumentValueDouble, sizeof(double)) == 0;
+	// The text can be the same for different bytes when it is cut off at the maximum number of elements.
+	case ESiriusStringFormatArgumentType::Bytes:
+		return ArgumentValue.Equals(Other.ArgumentValue, ESearchCase::CaseSensitive) && ArgumentValueBytes == Other.ArgumentValueBytes;
+	default:
+		break;
+	}
+	return true;
+}
+
+uint32 GetTypeHash(const FSiriusStringFormatArgument& Arg)
+{
+	switch (Arg.ArgumentValueType)
+	{
+	case ESiriusStringFormatArgumentType::Int:
+		return GetTypeHash(Arg.ArgumentValueInt);
+	case ESiriusStringFormatArgumentType::Int64:
+		return GetTypeHash(Arg.ArgumentValueInt64);
+	// Hash the bits, like the comparison.
+	case ESiriusStringFormatArgumentType::Float:
+		return GetTypeHash(Arg.ArgumentValueFloat);
+	case ESiriusStringFormatArgumentType::String:
+		// Case sensitive, like the comparison.
+		return FCrc::StrCrc32(*Arg.ArgumentValue);
+	case ESiriusStringFormatArgumentType::Double:
+		return GetTypeHash(Arg.ArgumentValueDouble);
+	case ESiriusStringFormatArgumentType::Bytes:
+		return HashCombine(FCrc::StrCrc32(*Arg.ArgumentValue), FCrc::MemCrc32(Arg.ArgumentValueBytes.GetData(), Arg.ArgumentValueBytes.Num()));
+	default:
+		break;
+	}
+	return 0;
+}
+
 void operator<<(FStructuredArchive::FSlot Slot, FSiriusStringFormatArgument& Value)
 {
 	FArchive& UnderlyingArchive = Slot.GetUnderlyingArchive();
@@ -68,17 +139,426 @@ void operator<<(FStructuredArchive::FSlot Slot, FSiriusStringFormatArgument& Val
 		break;
 	case ESiriusStringFormatArgumentType::Double:
 		Record << SA_VALUE(TEXT("Value"), Value.ArgumentValueDouble);
+		break;
+	case ESiriusStringFormatArgumentType::Bytes:
+		Record << SA_VALUE(TEXT("Value"), Value.ArgumentValue);
+		Record << SA_VALUE(TEXT("Bytes"), Value.ArgumentValueBytes);
+		break;
 	default:
 		break;
 	}
 }
 
+int32 USiriusStringLibrary::FindSubstring(const FString& SearchIn, const FString& Substring, const int32 StartPosition)
+{
+	return FSiriusStringSearch::Find(SearchIn, Substring, StartPosition);
+}
+
+int32 USiriusStringLibrary::CountSubstring(const FString& SearchIn, const FString& Substring)
+{
+	return FSiriusStringSearch::Count(SearchIn, Substring);
+}
+
+FString USiriusStringLibrary::ReplaceAll(const FString& SourceString, const FString& From, const FString& To)
+{
+	return FSiriusStringSearch::ReplaceAll(SourceString, From, To);
+}
+
+TArray<FString> USiriusStringLibrary::Split(const FString& SourceString, const FString& Delimiter, const bool bCullEmptyStrings)
+{
+	TArray<FStringView> Pieces;
+	FSiriusStringSearch::Split(SourceString, Delimiter, bCullEmptyStrings, Pieces);
+
+	TArray<FString> Result;
+	Result.Reserve(Pieces.Num());
+	for (const FStringView& Piece : Pieces)
+	{
+		Result.Emplace(Piece);
+	}
+	return Result;
+}
+
+FString USiriusStringLibrary::Join(const TArray<FString>& SourceArray, const FString& Separator)
+{
+	return FSiriusStringSearch::Join(SourceArray, Separator);
+}
+
+FString USiriusStringLibrary::Int64ToHex(const int64 Value, const int32 MinDigits, const bool bUpperCase)
+{
+	TStringBuilder<64> Builder;
+	FSiriusEncoding::AppendHex(static_cast<uint64>(Value), FMath::Clamp(MinDigits, 0, 64), bUpperCase, Builder);
+	return FString(Builder.ToView());
+}
+
+FString USiriusStringLibrary::Int64ToBinary(const int64 Value, const int32 MinDigits)
+{
+	TStringBuilder<72> Builder;
+	FSiriusEncoding::AppendBinary(static_cast<uint64>(Value), FMath::Clamp(MinDigits, 0, 64), Builder);
+	return FString(Builder.ToView());
+}
+
+FString USiriusStringLibrary::BytesToHex(const TArray<uint8>& Bytes, const bool bUpperCase)
+{
+	TStringBuilder<256> Builder;
+	FSiriusEncoding::AppendHex(Bytes, bUpperCase, Builder);
+	return FString(Builder.ToView());
+}
+
+FString USiriusStringLibrary::BytesToBase64(const TArray<uint8>& Bytes)
+{
+	TStringBuilder<256> Builder;
+	FSiriusEncoding::AppendBase64(Bytes, Builder);
+	return FString(Builder.ToView());
+}
+
+FString USiriusStringLibrary::StringToBase64(const FString& SourceString)
+{
+	const FTCHARToUTF8 Utf8(*SourceString, SourceString.Len());
+	TStringBuilder<256> Builder;
+	FSiriusEncoding::AppendBase64(TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()), Builder);
+	return FString(Builder.ToView());
+}
+
 FString USiriusStringLibrary::Format(const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs)
 {
-	TMap<FString, FStringFormatArg> Args;
-	for (const FSiriusStringFormatArgument& Arg : InArgs)
+	TArray<FSiriusStringFormatSegment> Segments;
+	FSiriusStringFormatPattern::Parse(InPattern, Segments);
+
+	TStringBuilder<256> Builder;
+	FSiriusStringFormatPattern::Format(InPattern, Segments, InArgs, Builder);
+	return FString(Builder.ToView());
+}
+
+FString USiriusStringLibrary::FormatLiteral(const int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs)
+{
+	TArray<FSiriusStringFormatSegment> LocalSegments;
+	const TConstArrayView<FSiriusStringFormatSegment> Segments = FSiriusPatternTable::Get().FindOrParse(PatternId, InPattern, LocalSegments);
+
+	TStringBuilder<256> Builder;
+	FSiriusStringFormatPattern::Format(InPattern, Segments, InArgs, Builder);
+	return FString(Builder.ToView());
+}
+
+FString USiriusStringLibrary::FormatCached(const UObject* Owner, const FName CallSite, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs)
+{
+	// The cache isn't locked, so thread-safe Blueprint functions running on workers always format.
+	if (!FSiriusFormatResultCache::IsEnabled())
+	{
+		return Format(InPattern, InArgs);
+	}
+
+	return FSiriusFormatResultCache::Get().FindOrFormat(Owner, CallSite, InPattern, InArgs);
+}
+
+FName USiriusStringLibrary::FormatName(const FName CallSite, const int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs)
+{
+	FSiriusFormatNameCache& Cache = FSiriusFormatNameCache::Get();
+	const bool bUseCache = FSiriusFormatNameCache::IsEnabled();
+
+	FName Result;
+	if (bUseCache && Cache.Find(CallSite, PatternId, InPattern, InArgs, Result))
+	{
+		return Result;
+	}
+
+	TArray<FSiriusStringFormatSegment> ParsedSegments;
+	TConstArrayView<FSiriusStringFormatSegment> Segments;
+	if (PatternId != 0)
+	{
+		Segments = FSiriusPatternTable::Get().FindOrParse(PatternId, InPattern, ParsedSegments);
+	}
+	else
+	{
+		FSiriusStringFormatPattern::Parse(InPattern, ParsedSegments);
+		Segments = ParsedSegments;
+	}
+
+	TStringBuilder<NAME_SIZE> Builder;
+	FSiriusStringFormatPattern::Format(InPattern, Segments, InArgs, Builder);
+	if (Builder.Len() >= NAME_SIZE)
+	{
+		UE_LOG(LogSiriusUtilityNodes, Warning, TEXT("Format Name result is too long for a name (%d characters): %.64s..."), Builder.Len(), Builder.ToString());
+		return NAME_None;
+	}
+
+	Result = FName(Builder.Len(), Builder.GetData());
+	if (bUseCache)
+	{
+		Cache.Store(CallSite, PatternId, InPattern, InArgs, Result);
+	}
+	return Result;
+}
+
+void USiriusStringLibrary::FormatAsync(const UObject* WorldContextObject, const FLatentActionInfo LatentInfo, const int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs, FString& OutResult)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (!World)
+	{
+		return;
+	}
+
+	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+	if (FSiriusFormatAsyncAction* ExistingAction = LatentActionManager.FindExistingAction<FSiriusFormatAsyncAction>(LatentInfo.CallbackTarget, LatentInfo.UUID))
+	{
+		ExistingAction->Restart(PatternId, InPattern, InArgs);
+	}
+	else
+	{
+		LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new FSiriusFormatAsyncAction(LatentInfo, PatternId, InPattern, InArgs, OutResult));
+	}
+}
+
+DEFINE_FUNCTION(USiriusStringLibrary::execFormatArrayArgument)
+{
+	P_GET_PROPERTY_REF(FStrProperty, ArgumentName);
+
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<FArrayProperty>(nullptr);
+	const void* ArrayAddr = Stack.MostRecentPropertyAddress;
+	const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+	P_GET_PROPERTY_REF(FStrProperty, Separator);
+	P_GET_PROPERTY(FIntProperty, MaxElements);
+	P_FINISH;
+
+	if (!ArrayProperty)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_NATIVE_BEGIN;
+	TStringBuilder<256> Builder;
+	FSiriusPropertyFormatter::AppendArray(ArrayProperty, ArrayAddr, Separator, MaxElements, Builder);
+
+	// Fill in the argument the "Make Array" node reads, rather than returning a string that is copied into it.
+	// The value keeps its allocation when the return value is reused, as it is in event graphs.
+	FSiriusStringFormatArgument& Argument = *static_cast<FSiriusStringFormatArgument*>(RESULT_PARAM);
+	Argument.ArgumentName = ArgumentName;
+	Argument.ArgumentValue.Reset(Builder.Len());
+	Argument.ArgumentValue.Append(Builder.ToString(), Builder.Len());
+
+	// Byte arrays also keep their raw bytes, so encoding specifiers like {Data:x} encode those rather than the text.
+	const FByteProperty* ByteProperty = CastField<FByteProperty>(ArrayProperty->Inner);
+	if (ByteProperty && !ByteProperty->Enum)
+	{
+		const FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayAddr);
+		Argument.ArgumentValueType = ESiriusStringFormatArgumentType::Bytes;
+		Argument.ArgumentValueBytes.Reset(ArrayHelper.Num());
+		Argument.ArgumentValueBytes.Append(ArrayHelper.Num() > 0 ? ArrayHelper.GetRawPtr(0) : nullptr, ArrayHelper.Num());
+	}
+	else
+	{
+		Argument.ArgumentValueType = ESiriusStringFormatArgumentType::String;
+		Argument.ArgumentValueBytes.Reset();
+	}
+	P_NATIVE_END;
+}
+
+DEFINE_FUNCTION(USiriusStringLibrary::execFormatStruct)
+{
+	Stack.MostRecentProperty = nullptr;
+	Stack.StepCompiledIn<FStructProperty>(nullptr);
+	const void* StructAddr = Stack.MostRecentPropertyAddress;
+	const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+	P_FINISH;
+
+	if (!StructProperty || !StructAddr)
+	{
+		Stack.bArrayContextFailed = true;
+		return;
+	}
+
+	P_NATIVE_BEGIN;
+	TStringBuilder<256> Builder;
+	FSiriusPropertyFormatter::AppendStruct(StructProperty->Struct, StructAddr, Builder);
+	*static_cast<FString*>(RESULT_PARAM) = FString(Builder.ToView());
+	P_NATIVE_END;
+}
+
+/** Parses a captured value, which must be a number in its entirety apart from surrounding whitespace */
+template <typename ValueType>
+static bool TryParseScannedValue(const FStringView Value, ValueType& OutValue)
+{
+	const FStringView Trimmed = Value.TrimStartAndEnd();
+	if (Trimmed.IsEmpty())
+	{
+		return false;
+	}
+
+	TStringBuilder<64> Builder;
+	Builder.Append(Trimmed.GetData(), Trimmed.Len());
+	return LexTryParseString(OutValue, Builder.ToString());
+}
+
+static bool TryParseScannedBool(const FStringView Value, int32& OutValue)
+{
+	const FStringView Trimmed = Value.TrimStartAndEnd();
+	if (Trimmed.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Trimmed == TEXT("1"))
+	{
+		OutValue = 1;
+		return true;
+	}
+	if (Trimmed.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Trimmed == TEXT("0"))
+	{
+		OutValue = 0;
+		return true;
+	}
+	return false;
+}
+
+bool USiriusStringLibrary::Scan(const int64 PatternId, const FString& InPattern, const FString& Source, const FString& TypeCodes, TArray<FSiriusStringFormatArgument>& OutValues)
+{
+	// Linked patterns change at runtime, only literal ones are worth keeping around parsed.
+	TArray<FSiriusStringFormatSegment> ParsedSegments;
+	TConstArrayView<FSiriusStringFormatSegment> Segments;
+	if (PatternId != 0)
+	{
+		Segments = FSiriusPatternTable::Get().FindOrParse(PatternId, InPattern, ParsedSegments);
+	}
+	else
+	{
+		FSiriusStringFormatPattern::Parse(InPattern, ParsedSegments);
+		Segments = ParsedSegments;
+	}
+
+	// Every argument gets a value, so the getters return defaults if the source doesn't match.
+	OutValues.Reset();
+	OutValues.SetNum(TypeCodes.Len());
+
+	TArray<FStringView> Values;
+	if (!FSiriusStringScanner::Match(InPattern, Segments, Source, Values))
 	{
-		Args.Emplace(Arg.ArgumentName, Arg.ToEngineFormatArg());
+		return false;
 	}
-	return FString::Format(*InPattern, Args);
+
+	bool bSuccess = true;
+	for (int32 ValueIdx = 0; ValueIdx < OutValues.Num(); ++ValueIdx)
+	{
+		FSiriusStringFormatArgument& OutValue = OutValues[ValueIdx];
+		const FStringView Value = Values.IsValidIndex(ValueIdx) ? Values[ValueIdx] : FStringView();
+
+		switch (TypeCodes[ValueIdx])
+		{
+		case FSiriusStringScanner::IntTypeCode:
+			OutValue.ArgumentValueType = ESiriusStringFormatArgumentType::Int;
+			bSuccess &= TryParseScannedValue(Value, OutValue.ArgumentValueInt);
+			break;
+		case FSiriusStringScanner::Int64TypeCode:
+			OutValue.ArgumentValueType = ESiriusStringFormatArgumentType::Int64;
+			bSuccess &= TryParseScannedValue(Value, OutValue.ArgumentValueInt64);
+			break;
+		case FSiriusStringScanner::FloatTypeCode:
+			OutValue.ArgumentValueType = ESiriusStringFormatArgumentType::Float;
+			bSuccess &= TryParseScannedValue(Value, OutValue.ArgumentValueFloat);
+			break;
+		case FSiriusStringScanner::DoubleTypeCode:
+			OutValue.ArgumentValueType = ESiriusStringFormatArgumentType::Double;
+			bSuccess &= TryParseScannedValue(Value, OutValue.ArgumentValueDouble);
+			break;
+		case FSiriusStringScanner::BoolTypeCode:
+			OutValue.ArgumentValueType = ESiriusStringFormatArgumentType::Int;
+			bSuccess &= TryParseScannedBool(Value, OutValue.ArgumentValueInt);
+			break;
+		default:
+			OutValue.ArgumentValue = FString(Value);
+			break;
+		}
+	}
+	return bSuccess;
+}
+
+int32 USiriusStringLibrary::GetScannedInt(const TArray<FSiriusStringFormatArgument>& Values, const int32 Index)
+{
+	return Values.IsValidIndex(Index) ? Values[Index].ArgumentValueInt : 0;
+}
+
+int64 USiriusStringLibrary::GetScannedInt64(const TArray<FSiriusStringFormatArgument>& Values, const int32 Index)
+{
+	return Values.IsValidIndex(Index) ? Values[Index].ArgumentValueInt64 : 0;
+}
+
+float USiriusStringLibrary::GetScannedFloat(const TArray<FSiriusStringFormatArgument>& Values, const int32 Index)
+{
+	return Values.IsValidIndex(Index) ? Values[Index].ArgumentValueFloat : 0.0f;
+}
+
+double USiriusStringLibrary::GetScannedDouble(const TArray<FSiriusStringFormatArgument>& Values, const int32 Index)
+{
+	return Values.IsValidIndex(Index) ? Values[Index].ArgumentValueDouble : 0.0;
+}
+
+bool USiriusStringLibrary::GetScannedBool(const TArray<FSiriusStringFormatArgument>& Values, const int32 Index)
+{
+	return Values.IsValidIndex(Index) && Values[Index].ArgumentValueInt != 0;
+}
+
+FString USiriusStringLibrary::GetScannedString(const TArray<FSiriusStringFormatArgument>& Values, const int32 Index)
+{
+	return Values.IsValidIndex(Index) ? Values[Index].ArgumentValue : FString();
+}
+
+FName USiriusStringLibrary::GetScannedName(const TArray<FSiriusStringFormatArgument>& Values, const int32 Index)
+{
+	return Values.IsValidIndex(Index) ? FName(*Values[Index].ArgumentValue) : NAME_None;
+}
+
+FText USiriusStringLibrary::GetScannedText(const TArray<FSiriusStringFormatArgument>& Values, const int32 Index)
+{
+	return Values.IsValidIndex(Index) ? FText::FromString(Values[Index].ArgumentValue) : FText::GetEmpty();
+}
+
+void USiriusStringLibrary::PrintString(const UObject* WorldContextObject, const FString& InString, const bool bPrintToScreen, const bool bPrintToLog, const FLinearColor TextColor, const float Duration)
+{
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST) // Do not print in Shipping or Test
+	if (bPrintToLog && FSiriusDebugOutputSink::IsEnabled())
+	{
+		// Keep the line out of the engine log, the screen message (if any) is still handled by the engine.
+		FSiriusDebugOutputSink::Get().WriteLine(InString);
+		if (bPrintToScreen)
+		{
+			UKismetSystemLibrary::PrintString(WorldContextObject, InString, true, false, TextColor, Duration);
+		}
+		return;
+	}
+
+	UKismetSystemLibrary::PrintString(WorldContextObject, InString, bPrintToScreen, bPrintToLog, TextColor, Duration);
+#endif
+}
+
+void USiriusStringLibrary::PrintStringFormatted(const UObject* WorldContextObject, const int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs, const bool bPrintToScreen, const bool bPrintToLog, const FLinearColor TextColor, const float Duration)
+{
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST) // Do not format or print in Shipping or Test
+	// Without screen or log output the engine still logs the string as Verbose, only skip the formatting when that is suppressed.
+	if (!bPrintToScreen && !bPrintToLog && LogBlueprintUserMessages.IsSuppressed(ELogVerbosity::Verbose))
+	{
+		return;
+	}
+
+	// Linked patterns change at runtime, only literal ones are worth keeping around parsed.
+	TArray<FSiriusStringFormatSegment> ParsedSegments;
+	TConstArrayView<FSiriusStringFormatSegment> Segments;
+	if (PatternId != 0)
+	{
+		Segments = FSiriusPatternTable::Get().FindOrParse(PatternId, InPattern, ParsedSegments);
+	}
+	else
+	{
+		FSiriusStringFormatPattern::Parse(InPattern, ParsedSegments);
+		Segments = ParsedSegments;
+	}
+
+	if (bPrintToLog && !bPrintToScreen && FSiriusDebugOutputSink::IsEnabled())
+	{
+		// The sink stores UTF-8, so format straight into it rather than through a TCHAR string.
+		TUtf8StringBuilder<256> Utf8Builder;
+		FSiriusStringFormatPattern::Format(InPattern, Segments, InArgs, Utf8Builder);
+		FSiriusDebugOutputSink::Get().WriteLine(Utf8Builder.ToView());
+		return;
+	}
+
+	TStringBuilder<256> Builder;
+	FSiriusStringFormatPattern::Format(InPattern, Segments, InArgs, Builder);
+	PrintString(WorldContextObject, FString(Builder.ToView()), bPrintToScreen, bPrintToLog, TextColor, Duration);
+#endif
 }
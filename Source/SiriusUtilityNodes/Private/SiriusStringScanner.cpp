@@ -0,0 +1,143 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusStringScanner.h"
+
+#include "SiriusStringSearch.h"
+
+namespace SiriusStringScanner
+{
+	static FStringView GetText(const FStringView Pattern, const FSiriusStringFormatSegment& Segment)
+	{
+		return Pattern.Mid(Segment.Offset, Segment.Length);
+	}
+
+	static FStringView GetName(const FStringView Pattern, const FSiriusStringFormatSegment& Segment)
+	{
+		return Pattern.Mid(Segment.NameOffset, Segment.NameLength);
+	}
+
+	/** Returns true if the literal segments from First up to End match the source at Position, outputs the position after them */
+	static bool MatchLiterals(const FStringView Pattern, const TConstArrayView<FSiriusStringFormatSegment> Segments, const int32 First, const int32 End, const FStringView Source, int32 Position, int32& OutEnd)
+	{
+		for (int32 SegmentIdx = First; SegmentIdx < End; ++SegmentIdx)
+		{
+			const FStringView Literal = GetText(Pattern, Segments[SegmentIdx]);
+			if (!Source.Mid(Position).StartsWith(Literal, ESearchCase::CaseSensitive))
+			{
+				return false;
+			}
+			Position += Literal.Len();
+		}
+		OutEnd = Position;
+		return true;
+	}
+
+	/** Finds where the run of literal segments from First up to End occurs in the source at or after Position */
+	static int32 FindLiterals(const FStringView Pattern, const TConstArrayView<FSiriusStringFormatSegment> Segments, const int32 First, const int32 End, const FStringView Source, const int32 Position)
+	{
+		int32 RunEnd;
+
+		// Literals ending the pattern have to end the source as well.
+		if (End == Segments.Num())
+		{
+			int32 RunLen = 0;
+			for (int32 SegmentIdx = First; SegmentIdx < End; ++SegmentIdx)
+			{
+				RunLen += Segments[SegmentIdx].Length;
+			}
+
+			const int32 RunStart = Source.Len() - RunLen;
+			return RunStart >= Position && MatchLiterals(Pattern, Segments, First, End, Source, RunStart, RunEnd) ? RunStart : INDEX_NONE;
+		}
+
+		const FStringView FirstLiteral = GetText(Pattern, Segments[First]);
+		for (int32 SearchStart = Position; ; )
+		{
+			const int32 Found = FSiriusStringSearch::Find(Source, FirstLiteral, SearchStart);
+			if (Found == INDEX_NONE || MatchLiterals(Pattern, Segments, First, End, Source, Found, RunEnd))
+			{
+				return Found;
+			}
+			SearchStart = Found + 1;
+		}
+	}
+}
+
+bool FSiriusStringScanner::Match(const FStringView InPattern, const TConstArrayView<FSiriusStringFormatSegment> InSegments, const FStringView Source, TArray<FStringView>& OutValues)
+{
+	using namespace SiriusStringScanner;
+
+	OutValues.Reset();
+	TArray<FStringView, TInlineAllocator<8>> Names;
+
+	// The text a choice produced can't be traced back to the value that chose it.
+	for (const FSiriusStringFormatSegment& Segment : InSegments)
+	{
+		if (Segment.NumChildren > 0)
+		{
+			return false;
+		}
+	}
+
+	int32 Position = 0;
+	for (int32 SegmentIdx = 0; SegmentIdx < InSegments.Num(); ++SegmentIdx)
+	{
+		const FSiriusStringFormatSegment& Segment = InSegments[SegmentIdx];
+		if (Segment.Type == ESiriusStringFormatSegmentType::Literal)
+		{
+			if (!MatchLiterals(InPattern, InSegments, SegmentIdx, SegmentIdx + 1, Source, Position, Position))
+			{
+				return false;
+			}
+			continue;
+		}
+
+		// Find where the argument ends
+		const int32 NextIdx = SegmentIdx + 1;
+		int32 ValueEnd;
+		if (NextIdx == InSegments.Num())
+		{
+			ValueEnd = Source.Len();
+		}
+		else if (InSegments[NextIdx].Type == ESiriusStringFormatSegmentType::Argument)
+		{
+			ValueEnd = Position;
+			while (ValueEnd < Source.Len() && !FChar::IsWhitespace(Source[ValueEnd]))
+			{
+				++ValueEnd;
+			}
+		}
+		else
+		{
+			int32 RunEnd = NextIdx;
+			while (RunEnd < InSegments.Num() && InSegments[RunEnd].Type == ESiriusStringFormatSegmentType::Literal)
+			{
+				++RunEnd;
+			}
+
+			ValueEnd = FindLiterals(InPattern, InSegments, NextIdx, RunEnd, Source, Position);
+			if (ValueEnd == INDEX_NONE)
+			{
+				return false;
+			}
+		}
+
+		const FStringView Value = Source.Mid(Position, ValueEnd - Position);
+		Position = ValueEnd;
+
+		// An argument used more than once must capture the same text every time.
+		const FStringView Name = GetName(InPattern, Segment);
+		const int32 NameIdx = Names.IndexOfByPredicate([Name](const FStringView ExistingName) { return Name.Equals(ExistingName, ESearchCase::CaseSensitive); });
+		if (NameIdx == INDEX_NONE)
+		{
+			Names.Add(Name);
+			OutValues.Add(Value);
+		}
+		else if (!OutValues[NameIdx].Equals(Value, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+
+	return Position == Source.Len();
+}
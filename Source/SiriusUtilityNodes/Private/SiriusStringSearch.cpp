@@ -0,0 +1,494 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusStringSearch.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON && !PLATFORM_TCHAR_IS_4_BYTES
+	#define SIRIUS_STRING_SEARCH_NEON 1
+	#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY && !PLATFORM_TCHAR_IS_4_BYTES
+	#define SIRIUS_STRING_SEARCH_SSE2 1
+	#include <emmintrin.h>
+#endif
+
+#ifndef SIRIUS_STRING_SEARCH_NEON
+	#define SIRIUS_STRING_SEARCH_NEON 0
+#endif
+#ifndef SIRIUS_STRING_SEARCH_SSE2
+	#define SIRIUS_STRING_SEARCH_SSE2 0
+#endif
+
+// Modules are built for SSE2 only, so AVX2 is used through intrinsics in functions compiled for it, after checking the CPU
+// supports it. MSVC accepts AVX2 intrinsics in any function, Clang and GCC only in functions targeting AVX2.
+#define SIRIUS_STRING_SEARCH_AVX2 SIRIUS_STRING_SEARCH_SSE2
+#if SIRIUS_STRING_SEARCH_AVX2
+	#include <immintrin.h>
+	#if PLATFORM_COMPILER_CLANG || defined(__GNUC__)
+		#include <cpuid.h>
+		#define SIRIUS_AVX2_FUNCTION __attribute__((target("avx2")))
+	#else
+		#include <intrin.h>
+		#define SIRIUS_AVX2_FUNCTION
+	#endif
+#endif
+
+namespace SiriusStringSearch
+{
+#if SIRIUS_STRING_SEARCH_SSE2 || SIRIUS_STRING_SEARCH_NEON
+	static_assert(sizeof(TCHAR) == sizeof(uint16), "The vectorized search compares 16-bit characters");
+
+	/** Number of characters compared at once */
+	static constexpr int32 NumLanes = 8;
+#endif
+
+#if SIRIUS_STRING_SEARCH_SSE2
+	/** Number of mask bits per lane */
+	static constexpr int32 LaneBits = 1;
+
+	/** Returns a mask of the lanes where the 8 characters at Chars equal Char */
+	static FORCEINLINE uint64 MatchLanes(const TCHAR* Chars, const TCHAR Char)
+	{
+		const __m128i Equal = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Chars)), _mm_set1_epi16(static_cast<int16>(Char)));
+		return static_cast<uint64>(_mm_movemask_epi8(_mm_packs_epi16(Equal, _mm_setzero_si128())));
+	}
+
+	/** Returns a mask of the lanes where both the 8 characters at A equal CharA and the 8 characters at B equal CharB */
+	static FORCEINLINE uint64 MatchLanes(const TCHAR* A, const TCHAR CharA, const TCHAR* B, const TCHAR CharB)
+	{
+		const __m128i EqualA = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(A)), _mm_set1_epi16(static_cast<int16>(CharA)));
+		const __m128i EqualB = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(B)), _mm_set1_epi16(static_cast<int16>(CharB)));
+		return static_cast<uint64>(_mm_movemask_epi8(_mm_packs_epi16(_mm_and_si128(EqualA, EqualB), _mm_setzero_si128())));
+	}
+
+	/** Returns a mask of the lanes where the 8 characters at Chars equal either CharA or CharB */
+	static FORCEINLINE uint64 MatchAnyLanes(const TCHAR* Chars, const TCHAR CharA, const TCHAR CharB)
+	{
+		const __m128i Loaded = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Chars));
+		const __m128i EqualA = _mm_cmpeq_epi16(Loaded, _mm_set1_epi16(static_cast<int16>(CharA)));
+		const __m128i EqualB = _mm_cmpeq_epi16(Loaded, _mm_set1_epi16(static_cast<int16>(CharB)));
+		return static_cast<uint64>(_mm_movemask_epi8(_mm_packs_epi16(_mm_or_si128(EqualA, EqualB), _mm_setzero_si128())));
+	}
+#elif SIRIUS_STRING_SEARCH_NEON
+	/** Number of mask bits per lane */
+	static constexpr int32 LaneBits = 8;
+
+	/** Narrows the 16-bit lanes of a comparison to one byte each */
+	static FORCEINLINE uint64 NarrowMask(const uint16x8_t Equal)
+	{
+		return vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(Equal)), 0);
+	}
+
+	/** Returns a mask of the lanes where the 8 characters at Chars equal Char */
+	static FORCEINLINE uint64 MatchLanes(const TCHAR* Chars, const TCHAR Char)
+	{
+		return NarrowMask(vceqq_u16(vld1q_u16(reinterpret_cast<const uint16*>(Chars)), vdupq_n_u16(static_cast<uint16>(Char))));
+	}
+
+	/** Returns a mask of the lanes where both the 8 characters at A equal CharA and the 8 characters at B equal CharB */
+	static FORCEINLINE uint64 MatchLanes(const TCHAR* A, const TCHAR CharA, const TCHAR* B, const TCHAR CharB)
+	{
+		const uint16x8_t EqualA = vceqq_u16(vld1q_u16(reinterpret_cast<const uint16*>(A)), vdupq_n_u16(static_cast<uint16>(CharA)));
+		const uint16x8_t EqualB = vceqq_u16(vld1q_u16(reinterpret_cast<const uint16*>(B)), vdupq_n_u16(static_cast<uint16>(CharB)));
+		return NarrowMask(vandq_u16(EqualA, EqualB));
+	}
+
+	/** Returns a mask of the lanes where the 8 characters at Chars equal either CharA or CharB */
+	static FORCEINLINE uint64 MatchAnyLanes(const TCHAR* Chars, const TCHAR CharA, const TCHAR CharB)
+	{
+		const uint16x8_t Loaded = vld1q_u16(reinterpret_cast<const uint16*>(Chars));
+		const uint16x8_t EqualA = vceqq_u16(Loaded, vdupq_n_u16(static_cast<uint16>(CharA)));
+		const uint16x8_t EqualB = vceqq_u16(Loaded, vdupq_n_u16(static_cast<uint16>(CharB)));
+		return NarrowMask(vorrq_u16(EqualA, EqualB));
+	}
+#endif
+
+	/** Compares the characters of a substring between its first and last character */
+	static FORCEINLINE bool MatchesInner(const TCHAR* Chars, const FStringView Substring)
+	{
+		return Substring.Len() <= 2 || FMemory::Memcmp(Chars + 1, Substring.GetData() + 1, (Substring.Len() - 2) * sizeof(TCHAR)) == 0;
+	}
+
+#if SIRIUS_STRING_SEARCH_AVX2
+	/** Returns true if both the CPU and the OS support AVX2, which is only checked once */
+	static bool HasAVX2()
+	{
+		static const bool bHasAVX2 = []()
+		{
+			uint32 Registers[4] = {};
+			auto CpuId = [&Registers](const uint32 Leaf)
+			{
+#if PLATFORM_COMPILER_CLANG || defined(__GNUC__)
+				__cpuid_count(Leaf, 0, Registers[0], Registers[1], Registers[2], Registers[3]);
+#else
+				__cpuidex(reinterpret_cast<int*>(Registers), Leaf, 0);
+#endif
+			};
+
+			CpuId(0);
+			if (Registers[0] < 7)
+			{
+				return false;
+			}
+
+			// The OS must save the upper halves of the YMM registers, which it reports through XGETBV.
+			CpuId(1);
+			constexpr uint32 OSXSAVEBit = 1u << 27;
+			constexpr uint32 AVXBit = 1u << 28;
+			if ((Registers[2] & (OSXSAVEBit | AVXBit)) != (OSXSAVEBit | AVXBit))
+			{
+				return false;
+			}
+
+#if PLATFORM_COMPILER_CLANG || defined(__GNUC__)
+			uint32 XCR0Low = 0;
+			uint32 XCR0High = 0;
+			__asm__ volatile("xgetbv" : "=a"(XCR0Low), "=d"(XCR0High) : "c"(0));
+			const uint64 XCR0 = (uint64(XCR0High) << 32) | XCR0Low;
+#else
+			const uint64 XCR0 = _xgetbv(0);
+#endif
+			constexpr uint64 SSEAndAVXState = 0x6;
+			if ((XCR0 & SSEAndAVXState) != SSEAndAVXState)
+			{
+				return false;
+			}
+
+			CpuId(7);
+			constexpr uint32 AVX2Bit = 1u << 5;
+			return (Registers[1] & AVX2Bit) != 0;
+		}();
+		return bHasAVX2;
+	}
+
+	/** Number of characters compared at once with AVX2 */
+	static constexpr int32 NumWideLanes = 16;
+
+	/** Returns the lowest lane set in a mask of 16 2-bit lanes and clears it */
+	static FORCEINLINE int32 PopLowestWideLane(uint32& Mask)
+	{
+		const int32 Lane = static_cast<int32>(FMath::CountTrailingZeros(Mask)) / 2;
+		Mask &= ~(3u << (Lane * 2));
+		return Lane;
+	}
+
+	/** Returns a mask of the lanes where the 16 characters at Chars equal either CharA or CharB, pass the same character twice to find one */
+	SIRIUS_AVX2_FUNCTION static FORCEINLINE uint32 MatchAnyWideLanes(const TCHAR* Chars, const TCHAR CharA, const TCHAR CharB)
+	{
+		const __m256i Loaded = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Chars));
+		const __m256i EqualA = _mm256_cmpeq_epi16(Loaded, _mm256_set1_epi16(static_cast<int16>(CharA)));
+		const __m256i EqualB = _mm256_cmpeq_epi16(Loaded, _mm256_set1_epi16(static_cast<int16>(CharB)));
+		return static_cast<uint32>(_mm256_movemask_epi8(_mm256_or_si256(EqualA, EqualB)));
+	}
+
+	/** Returns a mask of the lanes where both the 16 characters at A equal CharA and the 16 characters at B equal CharB */
+	SIRIUS_AVX2_FUNCTION static FORCEINLINE uint32 MatchWideLanes(const TCHAR* A, const TCHAR CharA, const TCHAR* B, const TCHAR CharB)
+	{
+		const __m256i EqualA = _mm256_cmpeq_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(A)), _mm256_set1_epi16(static_cast<int16>(CharA)));
+		const __m256i EqualB = _mm256_cmpeq_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(B)), _mm256_set1_epi16(static_cast<int16>(CharB)));
+		return static_cast<uint32>(_mm256_movemask_epi8(_mm256_and_si256(EqualA, EqualB)));
+	}
+
+	/**
+	 * Finds either character 16 characters at a time, from Index up to the last full block before Len.
+	 * Returns INDEX_NONE with Index at the first character that wasn't compared if there is no match.
+	 */
+	SIRIUS_AVX2_FUNCTION static int32 FindFirstOfAVX2(const TCHAR* Chars, const int32 Len, const TCHAR CharA, const TCHAR CharB, int32& Index)
+	{
+		for (; Index + NumWideLanes <= Len; Index += NumWideLanes)
+		{
+			uint32 Mask = MatchAnyWideLanes(Chars + Index, CharA, CharB);
+			if (Mask != 0)
+			{
+				return Index + PopLowestWideLane(Mask);
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Tests 16 start positions of a substring of at least 2 characters at a time, from Index up to the last full block
+	 * before LastStart. Returns INDEX_NONE with Index at the first position that wasn't tested if there is no match.
+	 */
+	SIRIUS_AVX2_FUNCTION static int32 FindAVX2(const TCHAR* Chars, const int32 LastStart, const FStringView Substring, int32& Index)
+	{
+		const int32 SubstringLen = Substring.Len();
+		const TCHAR FirstChar = Substring[0];
+		const TCHAR LastChar = Substring[SubstringLen - 1];
+
+		for (; Index + NumWideLanes - 1 <= LastStart; Index += NumWideLanes)
+		{
+			uint32 Mask = MatchWideLanes(Chars + Index, FirstChar, Chars + Index + SubstringLen - 1, LastChar);
+			while (Mask != 0)
+			{
+				const int32 MatchIndex = Index + PopLowestWideLane(Mask);
+				if (MatchesInner(Chars + MatchIndex, Substring))
+				{
+					return MatchIndex;
+				}
+			}
+		}
+		return INDEX_NONE;
+	}
+#endif
+
+#if SIRIUS_STRING_SEARCH_SSE2 || SIRIUS_STRING_SEARCH_NEON
+	/** Returns the lowest lane set in the mask and clears it */
+	static FORCEINLINE int32 PopLowestLane(uint64& Mask)
+	{
+		const int32 Lane = static_cast<int32>(FMath::CountTrailingZeros64(Mask)) / LaneBits;
+		Mask &= ~(((uint64(1) << LaneBits) - 1) << (Lane * LaneBits));
+		return Lane;
+	}
+#endif
+
+	/** Calls Visitor with the index of every non-overlapping occurrence of the substring, until it returns false */
+	template <typename VisitorType>
+	static void ForEachMatch(const FStringView Text, const FStringView Substring, int32 StartIndex, VisitorType&& Visitor)
+	{
+		while (true)
+		{
+			const int32 Index = FSiriusStringSearch::Find(Text, Substring, StartIndex);
+			if (Index == INDEX_NONE || !Visitor(Index))
+			{
+				return;
+			}
+			StartIndex = Index + Substring.Len();
+		}
+	}
+}
+
+const TCHAR* FSiriusStringSearch::GetImplementationName()
+{
+#if SIRIUS_STRING_SEARCH_SSE2
+	return SiriusStringSearch::HasAVX2() ? TEXT("AVX2") : TEXT("SSE2");
+#elif SIRIUS_STRING_SEARCH_NEON
+	return TEXT("NEON");
+#else
+	return TEXT("Scalar");
+#endif
+}
+
+int32 FSiriusStringSearch::FindChar(const FStringView Text, const TCHAR Char, const int32 StartIndex)
+{
+	using namespace SiriusStringSearch;
+
+	const TCHAR* Chars = Text.GetData();
+	const int32 Len = Text.Len();
+	int32 Index = FMath::Max(StartIndex, 0);
+
+#if SIRIUS_STRING_SEARCH_AVX2
+	if (HasAVX2())
+	{
+		const int32 MatchIndex = FindFirstOfAVX2(Chars, Len, Char, Char, Index);
+		if (MatchIndex != INDEX_NONE)
+		{
+			return MatchIndex;
+		}
+	}
+#endif
+
+#if SIRIUS_STRING_SEARCH_SSE2 || SIRIUS_STRING_SEARCH_NEON
+	for (; Index + NumLanes <= Len; Index += NumLanes)
+	{
+		uint64 Mask = MatchLanes(Chars + Index, Char);
+		if (Mask != 0)
+		{
+			return Index + PopLowestLane(Mask);
+		}
+	}
+#endif
+
+	for (; Index < Len; ++Index)
+	{
+		if (Chars[Index] == Char)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FSiriusStringSearch::FindFirstOf(const FStringView Text, const TCHAR CharA, const TCHAR CharB, const int32 StartIndex)
+{
+	using namespace SiriusStringSearch;
+
+	const TCHAR* Chars = Text.GetData();
+	const int32 Len = Text.Len();
+	int32 Index = FMath::Max(StartIndex, 0);
+
+#if SIRIUS_STRING_SEARCH_AVX2
+	if (HasAVX2())
+	{
+		const int32 MatchIndex = FindFirstOfAVX2(Chars, Len, CharA, CharB, Index);
+		if (MatchIndex != INDEX_NONE)
+		{
+			return MatchIndex;
+		}
+	}
+#endif
+
+#if SIRIUS_STRING_SEARCH_SSE2 || SIRIUS_STRING_SEARCH_NEON
+	for (; Index + NumLanes <= Len; Index += NumLanes)
+	{
+		uint64 Mask = MatchAnyLanes(Chars + Index, CharA, CharB);
+		if (Mask != 0)
+		{
+			return Index + PopLowestLane(Mask);
+		}
+	}
+#endif
+
+	for (; Index < Len; ++Index)
+	{
+		if (Chars[Index] == CharA || Chars[Index] == CharB)
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FSiriusStringSearch::Find(const FStringView Text, const FStringView Substring, const int32 StartIndex)
+{
+	using namespace SiriusStringSearch;
+
+	const int32 SubstringLen = Substring.Len();
+	if (SubstringLen == 0)
+	{
+		return INDEX_NONE;
+	}
+	if (SubstringLen == 1)
+	{
+		return FindChar(Text, Substring[0], StartIndex);
+	}
+
+	const TCHAR* Chars = Text.GetData();
+	const TCHAR FirstChar = Substring[0];
+	const TCHAR LastChar = Substring[SubstringLen - 1];
+
+	// Last index the substring can start at
+	const int32 LastStart = Text.Len() - SubstringLen;
+	int32 Index = FMath::Max(StartIndex, 0);
+
+#if SIRIUS_STRING_SEARCH_AVX2
+	if (HasAVX2())
+	{
+		const int32 MatchIndex = FindAVX2(Chars, LastStart, Substring, Index);
+		if (MatchIndex != INDEX_NONE)
+		{
+			return MatchIndex;
+		}
+	}
+#endif
+
+#if SIRIUS_STRING_SEARCH_SSE2 || SIRIUS_STRING_SEARCH_NEON
+	// Test 8 start positions at once, the loads of the last characters stay within the text.
+	for (; Index + NumLanes - 1 <= LastStart; Index += NumLanes)
+	{
+		uint64 Mask = MatchLanes(Chars + Index, FirstChar, Chars + Index + SubstringLen - 1, LastChar);
+		while (Mask != 0)
+		{
+			const int32 MatchIndex = Index + PopLowestLane(Mask);
+			if (MatchesInner(Chars + MatchIndex, Substring))
+			{
+				return MatchIndex;
+			}
+		}
+	}
+#endif
+
+	for (; Index <= LastStart; ++Index)
+	{
+		if (Chars[Index] == FirstChar && Chars[Index + SubstringLen - 1] == LastChar && MatchesInner(Chars + Index, Substring))
+		{
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FSiriusStringSearch::Count(const FStringView Text, const FStringView Substring)
+{
+	int32 NumMatches = 0;
+	SiriusStringSearch::ForEachMatch(Text, Substring, 0, [&NumMatches](int32)
+	{
+		++NumMatches;
+		return true;
+	});
+	return NumMatches;
+}
+
+FString FSiriusStringSearch::ReplaceAll(const FStringView Text, const FStringView From, const FStringView To)
+{
+	TArray<int32, TInlineAllocator<64>> MatchIndices;
+	SiriusStringSearch::ForEachMatch(Text, From, 0, [&MatchIndices](const int32 Index)
+	{
+		MatchIndices.Add(Index);
+		return true;
+	});
+
+	if (MatchIndices.Num() == 0)
+	{
+		return FString(Text);
+	}
+
+	FString Result;
+	Result.Reserve(Text.Len() + MatchIndices.Num() * (To.Len() - From.Len()));
+
+	int32 CopyStart = 0;
+	for (const int32 MatchIndex : MatchIndices)
+	{
+		Result.Append(Text.GetData() + CopyStart, MatchIndex - CopyStart);
+		Result.Append(To.GetData(), To.Len());
+		CopyStart = MatchIndex + From.Len();
+	}
+	Result.Append(Text.GetData() + CopyStart, Text.Len() - CopyStart);
+	return Result;
+}
+
+void FSiriusStringSearch::Split(const FStringView Text, const FStringView Delimiter, const bool bCullEmpty, TArray<FStringView>& OutPieces)
+{
+	OutPieces.Reset();
+
+	auto AddPiece = [&OutPieces, &Text, bCullEmpty](const int32 Start, const int32 End)
+	{
+		if (End > Start || !bCullEmpty)
+		{
+			OutPieces.Add(Text.Mid(Start, End - Start));
+		}
+	};
+
+	int32 PieceStart = 0;
+	SiriusStringSearch::ForEachMatch(Text, Delimiter, 0, [&](const int32 Index)
+	{
+		AddPiece(PieceStart, Index);
+		PieceStart = Index + Delimiter.Len();
+		return true;
+	});
+	AddPiece(PieceStart, Text.Len());
+}
+
+FString FSiriusStringSearch::Join(const TConstArrayView<FString> Strings, const FStringView Separator)
+{
+	if (Strings.Num() == 0)
+	{
+		return FString();
+	}
+
+	int32 TotalLen = Separator.Len() * (Strings.Num() - 1);
+	for (const FString& String : Strings)
+	{
+		TotalLen += String.Len();
+	}
+
+	FString Result;
+	Result.Reserve(TotalLen);
+	for (int32 Index = 0; Index < Strings.Num(); ++Index)
+	{
+		if (Index > 0)
+		{
+			Result.Append(Separator.GetData(), Separator.Len());
+		}
+		Result.Append(Strings[Index]);
+	}
+	return Result;
+}
@@ -2,4 +2,26 @@
 
 #include "SiriusUtilityNodes.h"
 
+#include "SiriusDebugOutputSink.h"
+#include "SiriusPatternTable.h"
+
+DEFINE_LOG_CATEGORY(LogSiriusUtilityNodes);
+
 IMPLEMENT_MODULE(FSiriusUtilityNodesModule, SiriusUtilityNodes)
+
+void FSiriusUtilityNodesModule::StartupModule()
+{
+	// Start the periodic flush of the debug output file, it stays idle until enabled
+	FSiriusDebugOutputSink::Get().Initialize();
+
+	// Map the pre-parsed literal patterns, if the project has generated them
+	FSiriusPatternTable::Get().Load(FSiriusPatternTable::GetDefaultFilename());
+}
+
+void FSiriusUtilityNodesModule::ShutdownModule()
+{
+	// Make sure no buffered debug output is lost
+	FSiriusDebugOutputSink::Get().Shutdown();
+
+	FSiriusPatternTable::Get().Unload();
+}
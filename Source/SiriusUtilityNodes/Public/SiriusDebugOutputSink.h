@@ -0,0 +1,85 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "Tasks/Task.h"
+
+class IFileHandle;
+
+/**
+ * Optional sink for formatted debug output, enabled with "Sirius.DebugOutputFile 1".
+ *
+ * Lines are appended to a large in-memory buffer and written to a per-session file in batches, either when the buffer
+ * exceeds "Sirius.DebugOutputFile.FlushSize" or every "Sirius.DebugOutputFile.FlushInterval" seconds. Full buffers are
+ * swapped with a second one and written by a background task, so callers never wait on file I/O. Once a file grows
+ * beyond "Sirius.DebugOutputFile.MaxSize" a new file is started. None of this goes through the engine log or its output devices.
+ */
+class SIRIUSUTILITYNODES_API FSiriusDebugOutputSink
+{
+public:
+	static FSiriusDebugOutputSink& Get();
+
+	/** Returns true if debug output should be routed to this sink instead of the engine log */
+	static bool IsEnabled();
+
+	/** Registers the periodic flush, called on module startup */
+	void Initialize();
+
+	/** Flushes any pending output and closes the current file, called on module shutdown */
+	void Shutdown();
+
+	/** Appends a single line to the sink, safe to call from any thread */
+	void WriteLine(FStringView Line);
+
+	/** Appends a single UTF-8 encoded line to the sink as-is, safe to call from any thread */
+	void WriteLine(FUtf8StringView Line);
+
+	/** Writes all buffered output to disk, waiting for a write in progress */
+	void Flush();
+
+	/** Returns the file currently being written to, empty if nothing was written yet */
+	FString GetCurrentFilename() const;
+
+private:
+	FSiriusDebugOutputSink();
+	~FSiriusDebugOutputSink();
+
+	bool OnTick(float DeltaTime);
+
+	/** Hands the buffer to the writer task, unless it is still busy writing the previous one */
+	void StartWriteLocked();
+
+	/** Writes WriteBuffer to the current file, called by the writer task and on flush */
+	void WriteToFile();
+
+	bool OpenNextFile();
+
+	/** Guards Buffer and the writer task */
+	mutable FCriticalSection CriticalSection;
+
+	/** Guards the file, held by the writer while it writes */
+	mutable FCriticalSection FileCriticalSection;
+
+	/** UTF-8 encoded output that has not been handed to the writer yet */
+	TArray<uint8> Buffer;
+
+	/** Output being written by the writer task, only touched by the writer while it runs */
+	TArray<uint8> WriteBuffer;
+
+	UE::Tasks::FTask WriteTask;
+
+	TUniquePtr<IFileHandle> FileHandle;
+	FString CurrentFilename;
+	int64 CurrentFileSize;
+	int32 FileIndex;
+
+	/** Timestamp shared by all files of this session */
+	FString SessionTimestamp;
+
+	double LastFlushTime;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,32 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+
+/**
+ * Table-driven hex, binary and Base64 encoding, written straight into the buffer of a string builder, and UTF-8 conversion.
+ * Integers are encoded as their unsigned bits, so negative values are written in two's complement.
+ */
+class SIRIUSUTILITYNODES_API FSiriusEncoding
+{
+public:
+	/** Appends the hex digits of a value without leading zeros, padded with zeros to MinDigits */
+	static void AppendHex(uint64 Value, int32 MinDigits, bool bUpperCase, FStringBuilderBase& Out);
+
+	/** Appends the binary digits of a value without leading zeros, padded with zeros to MinDigits */
+	static void AppendBinary(uint64 Value, int32 MinDigits, FStringBuilderBase& Out);
+
+	/** Appends two hex digits per byte, in order */
+	static void AppendHex(TConstArrayView<uint8> Bytes, bool bUpperCase, FStringBuilderBase& Out);
+
+	/** Appends eight binary digits per byte, in order */
+	static void AppendBinary(TConstArrayView<uint8> Bytes, FStringBuilderBase& Out);
+
+	/** Appends the standard padded Base64 encoding (RFC 4648) of the bytes */
+	static void AppendBase64(TConstArrayView<uint8> Bytes, FStringBuilderBase& Out);
+
+	/** Appends text as UTF-8, runs of ASCII are copied a character at a time without a conversion pass */
+	static void AppendUtf8(FStringView Text, FUtf8StringBuilderBase& Out);
+};
@@ -0,0 +1,114 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "SiriusStringFormatPattern.h"
+#include "SiriusStringLibrary.h"
+#include "UObject/Object.h"
+#include "SiriusFormattedString.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSiriusFormattedStringChanged, const FString&, NewString);
+
+/**
+ * A formatted string that is only formatted again when one of its arguments changes, instead of every time it is read.
+ * Arguments are changed through the setters, or by binding them to a field notification of another object (UE 5.1+).
+ * Changes made during a frame are combined, OnChanged is broadcast once at the next tick if the result actually changed.
+ */
+UCLASS(BlueprintType)
+class SIRIUSUTILITYNODES_API USiriusFormattedString final : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Creates a formatted string using the "{Name}" argument syntax */
+	UFUNCTION(BlueprintCallable, Category="Utilities|String", meta=(DefaultToSelf="Outer"))
+	static USiriusFormattedString* CreateFormattedString(UObject* Outer, const FString& Pattern);
+
+	//~ Begin UObject Interface
+	virtual void BeginDestroy() override;
+	//~ End UObject Interface
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetPattern(const FString& InPattern);
+
+	UFUNCTION(BlueprintPure, Category="Utilities|String")
+	FString GetPattern() const { return Pattern.GetPattern(); }
+
+	/** Returns the formatted string, formatting it first if any argument changed */
+	UFUNCTION(BlueprintPure, Category="Utilities|String")
+	FString GetString();
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetIntArgument(const FString& ArgumentName, int32 Value);
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetInt64Argument(const FString& ArgumentName, int64 Value);
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetFloatArgument(const FString& ArgumentName, float Value);
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetDoubleArgument(const FString& ArgumentName, double Value);
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetStringArgument(const FString& ArgumentName, const FString& Value);
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetTextArgument(const FString& ArgumentName, const FText& Value);
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetNameArgument(const FString& ArgumentName, FName Value);
+
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void SetBoolArgument(const FString& ArgumentName, bool Value);
+
+	/**
+	 * Binds an argument to a property of another object, the argument is updated whenever that property's field notification is broadcast.
+	 * Requires the source object to implement INotifyFieldValueChanged (e.g. a view model or widget), only available in UE 5.1 and later.
+	 *
+	 * @param ArgumentName		The argument to update
+	 * @param Source			The object owning the property
+	 * @param FieldName			Name of the property, which must be a field notification
+	 * @return					True if the binding was made
+	 */
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	bool BindArgumentToField(const FString& ArgumentName, UObject* Source, FName FieldName);
+
+	/** Removes all field bindings */
+	UFUNCTION(BlueprintCallable, Category="Utilities|String")
+	void UnbindAllFields();
+
+	/** Broadcast once per frame, at most, when the formatted string changed */
+	UPROPERTY(BlueprintAssignable, Category="Utilities|String")
+	FSiriusFormattedStringChanged OnChanged;
+
+private:
+	/** Sets an argument value, marking the string dirty if it differs from the current value */
+	void SetArgument(const FSiriusStringFormatArgument& InArgument);
+
+	/** Reads the current value of a bound property into its argument */
+	void UpdateArgumentFromField(const FString& ArgumentName, const UObject* Source, FName FieldName);
+
+	void MarkDirty();
+	void UpdateString();
+	bool OnTick(float DeltaTime);
+
+	FSiriusStringFormatPattern Pattern;
+	TArray<FSiriusStringFormatArgument> Arguments;
+
+	FString FormattedString;
+	bool bDirty = false;
+	bool bPendingBroadcast = false;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	struct FFieldBinding
+	{
+		TWeakObjectPtr<UObject> Source;
+		FName FieldName;
+		FDelegateHandle Handle;
+	};
+	TArray<FFieldBinding> FieldBindings;
+};
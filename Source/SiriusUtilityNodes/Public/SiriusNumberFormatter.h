@@ -0,0 +1,22 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SiriusStringFormatPattern.h"
+#include "Misc/StringBuilder.h"
+
+/**
+ * Appends numbers in the representations of the pattern specifiers, without FText or culture data.
+ * The output is the same on every platform and language: "," groups digits and "." separates fractions.
+ *
+ *   Grouped	1,234,567.25	Up to 3 fraction digits, trailing zeros are trimmed.
+ *   Compact	1.2K, 15M, 3B	1 fraction digit, with the suffixes K, M, B and T.
+ *   Bytes		512 B, 1.5 MiB	1 fraction digit, with binary units up to EiB.
+ */
+class SIRIUSUTILITYNODES_API FSiriusNumberFormatter
+{
+public:
+	static void AppendInteger(int64 Value, ESiriusStringFormatSpecifier Specifier, FStringBuilderBase& Out);
+	static void AppendReal(double Value, ESiriusStringFormatSpecifier Specifier, FStringBuilderBase& Out);
+};
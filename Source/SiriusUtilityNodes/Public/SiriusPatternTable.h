@@ -0,0 +1,104 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "SiriusStringFormatPattern.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Table of pre-parsed literal patterns, generated by the SiriusPatternTable commandlet and mapped into memory at startup.
+ *
+ * Patterns are referenced by an ID that is a hash of their contents, which Format String nodes with a literal pattern
+ * compute during compilation. The table only stores segment ranges, the pattern text itself is still provided by the caller.
+ * Patterns that aren't in the table are parsed on first use instead, so a missing or outdated table is never an error.
+ */
+class SIRIUSUTILITYNODES_API FSiriusPatternTable
+{
+public:
+	static FSiriusPatternTable& Get();
+
+	~FSiriusPatternTable();
+
+	/** Returns the ID used to look up a pattern, identical on every platform */
+	static int64 GetPatternId(FStringView Pattern);
+
+	/** Returns the location of the table within the project */
+	static FString GetDefaultFilename();
+
+	/** Maps the table into memory, called on module startup */
+	void Load(const FString& Filename);
+
+	/** Releases the table */
+	void Unload();
+
+	/**
+	 * Returns the segments of a pattern, parsing and remembering it if it isn't part of the table.
+	 * A pattern whose ID is already taken by a pattern of a different length is parsed into LocalSegments instead.
+	 *
+	 * @param PatternId		ID of the pattern, as returned by GetPatternId
+	 * @param Pattern		The pattern itself
+	 * @param LocalSegments	Storage for the segments of a pattern that can't be remembered
+	 * @return				The segments, valid for as long as the module is loaded, or as long as LocalSegments if they were parsed into it
+	 */
+	TConstArrayView<FSiriusStringFormatSegment> FindOrParse(int64 PatternId, FStringView Pattern, TArray<FSiriusStringFormatSegment>& LocalSegments);
+
+	/** Returns the number of patterns in the loaded table */
+	int32 Num() const { return NumEntries; }
+
+#if WITH_EDITOR
+	/** Parses the given patterns and writes them to a table file */
+	static bool Save(const FString& Filename, const TArray<FString>& Patterns);
+#endif
+
+private:
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumEntries;
+		uint32 NumSegments;
+	};
+
+	struct FEntry
+	{
+		uint64 PatternId;
+		uint32 PatternLength;
+		uint32 FirstSegment;
+		uint32 NumSegments;
+		uint32 Padding;
+	};
+
+	static constexpr uint32 Magic = 0x54505253; // "SRPT"
+	static constexpr uint32 Version = 4;
+
+	/** Returns true if all entries refer to segments in the table and all segments to characters of their pattern, with binary searchable IDs */
+	static bool AreEntriesValid(TConstArrayView<FEntry> InEntries, const FSiriusStringFormatSegment* InSegments, uint32 InNumSegments);
+
+	/** Returns the table's segments of a pattern, or an empty view if it isn't part of the table */
+	TConstArrayView<FSiriusStringFormatSegment> Find(int64 PatternId, int32 PatternLength) const;
+
+	TUniquePtr<IMappedFileHandle> MappedHandle;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** Used instead of a mapping on platforms (or pak files) that don't support them */
+	TArray<uint8> LoadedData;
+
+	const FEntry* Entries = nullptr;
+	const FSiriusStringFormatSegment* Segments = nullptr;
+	int32 NumEntries = 0;
+
+	/** A pattern that wasn't part of the table, with its length to detect IDs of different patterns that collide */
+	struct FParsedPattern
+	{
+		int32 PatternLength = 0;
+		TArray<FSiriusStringFormatSegment> Segments;
+	};
+
+	/** Patterns that weren't part of the table, parsed on first use */
+	FRWLock ParsedPatternsLock;
+	TMap<int64, FParsedPattern> ParsedPatterns;
+};
@@ -0,0 +1,34 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+
+class FArrayProperty;
+class FProperty;
+class UScriptStruct;
+
+/**
+ * Appends property values to a string builder, in the same representation the format nodes use for arguments of that type,
+ * e.g. enums by their display name and booleans as "true" or "false".
+ * Structs are appended as "(Field=Value, ...)" using a formatter cached per native struct, core math types like FVector,
+ * FRotator and FTransform as by their ToString conversion nodes.
+ */
+class SIRIUSUTILITYNODES_API FSiriusPropertyFormatter
+{
+public:
+	/** Appends a single value of the property, values of unsupported properties are skipped */
+	static void AppendValue(const FProperty* Property, const void* Value, FStringBuilderBase& Out);
+
+	/** Appends all supported fields of a struct value */
+	static void AppendStruct(const UScriptStruct* Struct, const void* StructValue, FStringBuilderBase& Out);
+
+	/**
+	 * Appends all elements of an array in a single pass, resolving the element type only once.
+	 *
+	 * @param Separator		Placed between elements.
+	 * @param MaxElements	Number of elements to append, the remaining ones are summarized by their count. 0 appends all.
+	 */
+	static void AppendArray(const FArrayProperty* ArrayProperty, const void* ArrayValue, FStringView Separator, int32 MaxElements, FStringBuilderBase& Out);
+};
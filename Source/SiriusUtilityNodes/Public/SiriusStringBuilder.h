@@ -0,0 +1,53 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "SiriusStringBuilder.generated.h"
+
+struct FSiriusStringFormatArgument;
+
+/**
+ * Builds a string by appending to it in place. Appending to a string variable copies the whole string every time,
+ * while the builder's storage grows geometrically, so building a string piece by piece takes linear time.
+ */
+USTRUCT(BlueprintType, meta=(DisplayName="String Builder (Sirius)"))
+struct SIRIUSUTILITYNODES_API FSiriusStringBuilder
+{
+	GENERATED_BODY()
+
+	/** The string built so far, its slack is kept between appends */
+	FString Buffer;
+};
+
+UCLASS(meta=(BlueprintThreadSafe, ScriptName="SiriusStringBuilderLibrary"))
+class SIRIUSUTILITYNODES_API USiriusStringBuilderLibrary final : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Appends a string to the end of the builder */
+	UFUNCTION(BlueprintCallable, Category="Utilities|String|Builder", meta=(DisplayName="Append (String Builder)", Keywords="concatenate add"))
+	static void Append(UPARAM(ref) FSiriusStringBuilder& Builder, const FString& InString);
+
+	/** Makes room for at least the given number of characters in total, so appending up to that length doesn't reallocate */
+	UFUNCTION(BlueprintCallable, Category="Utilities|String|Builder", meta=(DisplayName="Reserve (String Builder)"))
+	static void Reserve(UPARAM(ref) FSiriusStringBuilder& Builder, int32 NumChars);
+
+	/** Empties the builder, keeping its storage for building the next string */
+	UFUNCTION(BlueprintCallable, Category="Utilities|String|Builder", meta=(DisplayName="Reset (String Builder)", Keywords="clear empty"))
+	static void Reset(UPARAM(ref) FSiriusStringBuilder& Builder);
+
+	/** Returns the number of characters built so far */
+	UFUNCTION(BlueprintPure, Category="Utilities|String|Builder", meta=(DisplayName="Length (String Builder)"))
+	static int32 Len(const FSiriusStringBuilder& Builder);
+
+	/** Returns the string built so far */
+	UFUNCTION(BlueprintPure, Category="Utilities|String|Builder", meta=(DisplayName="To String (String Builder)", CompactNodeTitle="->", BlueprintAutocast))
+	static FString Conv_StringBuilderToString(const FSiriusStringBuilder& Builder);
+
+	/* Appends a formatted pattern for the UK2Node_SiriusAppendFormatted, PatternId is the ID of a literal pattern or 0 if the pattern is not known at compile time */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true"))
+	static void AppendFormatted(UPARAM(ref) FSiriusStringBuilder& Builder, int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs);
+};
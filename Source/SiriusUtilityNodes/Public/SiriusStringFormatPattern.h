@@ -0,0 +1,154 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+
+struct FSiriusStringFormatArgument;
+
+enum class ESiriusStringFormatSegmentType : uint8
+{
+	Literal,
+	Argument,
+
+	/** "{Count|plural(one=item,other=items)}", followed by its choices */
+	Plural,
+
+	/** "{Mode|select(Fast=quick,other=slow)}", followed by its choices */
+	Select,
+
+	/** "{bShow|if(Text)}" or "{bShow|if(Text,Otherwise)}", followed by its choices */
+	Conditional,
+
+	/** One choice of the segment it follows, the name is its key. Followed by the segments of its text. */
+	Choice,
+};
+
+/** How the value of an argument is formatted, set by a specifier after its name: "{Name:n}" */
+enum class ESiriusStringFormatSpecifier : uint8
+{
+	None,
+
+	/** "n", digits in groups of three: 1,234,567.5 */
+	Grouped,
+
+	/** "c", compact with a magnitude suffix: 1.2M */
+	Compact,
+
+	/** "b", a size in bytes with binary units: 1.5 MiB */
+	Bytes,
+
+	/** "x" or "x8", hex digits padded to an optional width: ff, 000000ff */
+	Hex,
+
+	/** "X" or "X8", upper case hex digits: FF */
+	HexUpperCase,
+
+	/** "bin" or "bin8", binary digits: 101, 00000101 */
+	Bits,
+
+	/** "b64", the Base64 encoding of a string's UTF-8 bytes or of a byte array */
+	Base64,
+};
+
+/** A piece of a parsed pattern, stored as a range of the pattern string so it doesn't need its own allocation */
+struct FSiriusStringFormatSegment
+{
+	ESiriusStringFormatSegmentType Type = ESiriusStringFormatSegmentType::Literal;
+
+	/** Only used by argument segments */
+	ESiriusStringFormatSpecifier Specifier = ESiriusStringFormatSpecifier::None;
+
+	/** Minimum number of digits of the hex and binary specifiers, 0 if not given */
+	uint8 SpecifierWidth = 0;
+
+	/** Range of the whole segment, for arguments this includes the braces */
+	int32 Offset = 0;
+	int32 Length = 0;
+
+	/** Range of the argument name, only used by argument segments */
+	int32 NameOffset = 0;
+	int32 NameLength = 0;
+
+	/** Number of segments following this one that are part of it, the choices of a plural for example */
+	int32 NumChildren = 0;
+
+	/** Returns true if the name of the segment refers to an argument */
+	bool HasArgumentName() const
+	{
+		return Type == ESiriusStringFormatSegmentType::Argument || Type == ESiriusStringFormatSegmentType::Plural
+			|| Type == ESiriusStringFormatSegmentType::Select || Type == ESiriusStringFormatSegmentType::Conditional;
+	}
+};
+
+/**
+ * A pattern using the "{Name}" argument syntax of FString::Format, parsed once into segments so it can be formatted many times.
+ * Braces can be escaped with a backtick ("`{"). Arguments that aren't provided are left in the result as-is.
+ * Arguments can be given a specifier, e.g. "{Gold:n}" or "{Mask:x8}", see ESiriusStringFormatSpecifier.
+ * Hex and binary specifiers write integers as their bits, strings as their UTF-8 bytes and byte arrays as their bytes.
+ *
+ * Arguments can also choose between texts, without FText and with the same rules for every culture:
+ *   "{Count|plural(zero=no items,one=an item,other=items)}"	"one" is used for exactly 1, "zero" falls back to "other".
+ *   "{Mode|select(Fast=quickly,other=slowly)}"			Matches the formatted value, "other" is used if nothing matches.
+ *   "{bShow|if(shown)}", "{bShow|if(shown,hidden)}"		Numbers other than 0 and strings other than "", "false", "0" and "None" are true.
+ * The texts can contain arguments themselves, which are only formatted if their text is chosen. "`," and "`)" escape the
+ * characters ending a text.
+ */
+class SIRIUSUTILITYNODES_API FSiriusStringFormatPattern
+{
+public:
+	FSiriusStringFormatPattern() = default;
+	explicit FSiriusStringFormatPattern(FString InPattern);
+
+	/** Returns the pattern string the segments refer to */
+	const FString& GetPattern() const { return Pattern; }
+
+	TConstArrayView<FSiriusStringFormatSegment> GetSegments() const { return Segments; }
+
+	/** Returns the unique argument names used by the pattern, in order of appearance */
+	void GetArgumentNames(TArray<FString>& OutArgumentNames) const;
+
+	/** Appends the formatted pattern to a string builder */
+	void Format(TConstArrayView<FSiriusStringFormatArgument> Args, FStringBuilderBase& Out) const;
+
+	/** Appends the formatted pattern as UTF-8, for output written to logs, files or sockets without a TCHAR string in between */
+	void Format(TConstArrayView<FSiriusStringFormatArgument> Args, FUtf8StringBuilderBase& Out) const;
+
+	/** Returns the formatted pattern */
+	FString Format(TConstArrayView<FSiriusStringFormatArgument> Args) const;
+
+	/** Splits a pattern into literal and argument segments */
+	static void Parse(FStringView InPattern, TArray<FSiriusStringFormatSegment>& OutSegments);
+
+	/**
+	 * Checks that segments read from outside, e.g. from the pattern table, only refer to characters of the pattern and
+	 * nest their children the way Parse does, so Format can follow them without bounds checks.
+	 */
+	static bool AreSegmentsValid(int32 PatternLength, TConstArrayView<FSiriusStringFormatSegment> InSegments);
+
+	/** Appends a pattern, using previously parsed segments of it, to a string builder */
+	static void Format(FStringView InPattern, TConstArrayView<FSiriusStringFormatSegment> InSegments, TConstArrayView<FSiriusStringFormatArgument> Args, FStringBuilderBase& Out);
+
+	/** Appends a pattern as UTF-8, using previously parsed segments of it, to a string builder */
+	static void Format(FStringView InPattern, TConstArrayView<FSiriusStringFormatSegment> InSegments, TConstArrayView<FSiriusStringFormatArgument> Args, FUtf8StringBuilderBase& Out);
+
+	/** Appends a pattern, using previously parsed segments of it, to a string that grows as it is appended to, like the one of a FSiriusStringBuilder */
+	static void Format(FStringView InPattern, TConstArrayView<FSiriusStringFormatSegment> InSegments, TConstArrayView<FSiriusStringFormatArgument> Args, FString& Out);
+
+	/** Appends the value of a single argument to a string builder, in the same representation as FString::Format unless a specifier is given */
+	static void AppendArgument(const FSiriusStringFormatArgument& Arg, FStringBuilderBase& Out, ESiriusStringFormatSpecifier Specifier = ESiriusStringFormatSpecifier::None, int32 SpecifierWidth = 0);
+
+	/** Appends the value of a single argument as UTF-8 */
+	static void AppendArgument(const FSiriusStringFormatArgument& Arg, FUtf8StringBuilderBase& Out, ESiriusStringFormatSpecifier Specifier = ESiriusStringFormatSpecifier::None, int32 SpecifierWidth = 0);
+
+	/** Appends the value of a single argument to a string */
+	static void AppendArgument(const FSiriusStringFormatArgument& Arg, FString& Out, ESiriusStringFormatSpecifier Specifier = ESiriusStringFormatSpecifier::None, int32 SpecifierWidth = 0);
+
+	/** Returns the specifier written as the given text in a pattern and its width, or false if there is no such specifier */
+	static bool ParseSpecifier(FStringView Text, ESiriusStringFormatSpecifier& OutSpecifier, uint8& OutWidth);
+
+private:
+	FString Pattern;
+	TArray<FSiriusStringFormatSegment> Segments;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/LatentActionManager.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "SiriusStringLibrary.generated.h"
 
@@ -14,6 +15,8 @@ enum class ESiriusStringFormatArgumentType : uint8
 	Float,
 	String,
 	Double,
+	/** A byte array, formatted like a string from ArgumentValue but encoded from its raw ArgumentValueBytes */
+	Bytes,
 };
 
 /** Used to pass argument/value pairs into FString::Format. */
@@ -41,6 +44,10 @@ struct FSiriusStringFormatArgument
 	UPROPERTY(EditInstanceOnly, BlueprintReadWrite, Category=ArgumentValue)
 	double ArgumentValueDouble;
 
+	/** The raw bytes of a Bytes argument, set by FormatArrayArgument */
+	UPROPERTY()
+	TArray<uint8> ArgumentValueBytes;
+
 	FSiriusStringFormatArgument()
 	{
 		ResetValue();
@@ -50,6 +57,13 @@ struct FSiriusStringFormatArgument
 	
 	FStringFormatArg ToEngineFormatArg() const;
 
+	/** Returns true if both arguments have the same name, type and value */
+	bool operator==(const FSiriusStringFormatArgument& Other) const;
+	bool operator!=(const FSiriusStringFormatArgument& Other) const { return !(*this == Other); }
+
+	/** Hashes the value, arguments that compare equal have the same hash */
+	friend uint32 GetTypeHash(const FSiriusStringFormatArgument& Arg);
+
 	friend void operator<<(FStructuredArchive::FSlot Slot, FSiriusStringFormatArgument& Value);
 };
 
@@ -59,7 +73,110 @@ class SIRIUSUTILITYNODES_API USiriusStringLibrary final : public UBlueprintFunct
 	GENERATED_BODY()
 
 public:
-	/* Used for formatting a string using the FString::Format function and utilized by the UK2Node_SiriusFormatString */
+	/** Finds the first occurrence of a substring at or after StartPosition, case sensitively, using vectorized search. Returns -1 if it was not found. */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="Find Substring (Sirius)"))
+	static int32 FindSubstring(const FString& SearchIn, const FString& Substring, int32 StartPosition = 0);
+
+	/** Returns the number of non-overlapping occurrences of a substring, case sensitively */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="Count Substring (Sirius)"))
+	static int32 CountSubstring(const FString& SearchIn, const FString& Substring);
+
+	/** Replaces all occurrences of From by To, case sensitively, allocating the result only once */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="Replace All (Sirius)"))
+	static FString ReplaceAll(const FString& SourceString, const FString& From, const FString& To);
+
+	/** Splits a string by a delimiter, case sensitively, allocating the array once */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="Split (Sirius)", Keywords="parse into array"))
+	static TArray<FString> Split(const FString& SourceString, const FString& Delimiter, bool bCullEmptyStrings = true);
+
+	/** Joins strings with a separator, allocating the result only once */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="Join (Sirius)"))
+	static FString Join(const TArray<FString>& SourceArray, const FString& Separator);
+
+	/** Converts an integer to hex digits, negative values as their two's complement. The digits are padded with zeros to MinDigits. */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="To Hex (Sirius)", Keywords="hexadecimal"))
+	static FString Int64ToHex(int64 Value, int32 MinDigits = 0, bool bUpperCase = false);
+
+	/** Converts an integer to binary digits, negative values as their two's complement. The digits are padded with zeros to MinDigits. */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="To Binary (Sirius)", Keywords="bits"))
+	static FString Int64ToBinary(int64 Value, int32 MinDigits = 0);
+
+	/** Converts bytes to two hex digits each, e.g. for hashes */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="Bytes To Hex (Sirius)", Keywords="hexadecimal hash"))
+	static FString BytesToHex(const TArray<uint8>& Bytes, bool bUpperCase = false);
+
+	/** Encodes bytes as standard Base64 */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="Bytes To Base64 (Sirius)", Keywords="encode"))
+	static FString BytesToBase64(const TArray<uint8>& Bytes);
+
+	/** Encodes the UTF-8 bytes of a string as standard Base64 */
+	UFUNCTION(BlueprintPure, Category="Utilities|String", meta=(DisplayName="String To Base64 (Sirius)", Keywords="encode"))
+	static FString StringToBase64(const FString& SourceString);
+
+	/* Used for formatting a string using the FString::Format syntax and utilized by the UK2Node_SiriusFormatString */
 	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
 	static FString Format(const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs);
+
+	/* Same as Format, for literal patterns whose pre-parsed segments are looked up in the FSiriusPatternTable by ID */
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static FString FormatLiteral(int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs);
+
+	/* Same as Format, but returns the previous result of the call site in the Owner instance if the pattern and arguments did not change since then. Off the game thread it always formats. */
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true", DefaultToSelf = "Owner", HidePin = "Owner"))
+	static FString FormatCached(const UObject* Owner, FName CallSite, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs);
+
+	/* Formats a name for the UK2Node_SiriusFormatName, returning the name previously formatted by the call site for the same pattern and argument values. Off the game thread it always formats. PatternId is 0 for linked patterns. */
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static FName FormatName(FName CallSite, int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs);
+
+	/* Formats on a background task for the UK2Node_SiriusFormatStringAsync, Completed fires on the game thread with OutResult set. Calling it again while formatting starts over with the new arguments. PatternId is 0 for linked patterns. */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject", NotBlueprintThreadSafe))
+	static void FormatAsync(const UObject* WorldContextObject, FLatentActionInfo LatentInfo, int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs, FString& OutResult);
+
+	/* Formats all elements of an array in one pass, in the representation used for arguments of the element type, straight into the returned argument. Utilized by the format nodes. */
+	UFUNCTION(BlueprintPure, CustomThunk, meta=(BlueprintInternalUseOnly = "true", ArrayParm = "InArray"))
+	static FSiriusStringFormatArgument FormatArrayArgument(const FString& ArgumentName, const TArray<int32>& InArray, const FString& Separator, int32 MaxElements);
+	DECLARE_FUNCTION(execFormatArrayArgument);
+
+	/* Formats a struct argument as "(Field=Value, ...)", or core math types like their ToString conversion, utilized by the format nodes */
+	UFUNCTION(BlueprintPure, CustomThunk, meta=(BlueprintInternalUseOnly = "true", CustomStructureParam = "InStruct"))
+	static FString FormatStruct(const int32& InStruct);
+	DECLARE_FUNCTION(execFormatStruct);
+
+	/* Matches a string against a pattern for the UK2Node_SiriusScanString and converts the captured arguments, TypeCodes holds one FSiriusStringScanner type code per argument */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true"))
+	static bool Scan(int64 PatternId, const FString& InPattern, const FString& Source, const FString& TypeCodes, TArray<FSiriusStringFormatArgument>& OutValues);
+
+	/* Getters of the values converted by Scan, utilized by the UK2Node_SiriusScanString */
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static int32 GetScannedInt(const TArray<FSiriusStringFormatArgument>& Values, int32 Index);
+
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static int64 GetScannedInt64(const TArray<FSiriusStringFormatArgument>& Values, int32 Index);
+
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static float GetScannedFloat(const TArray<FSiriusStringFormatArgument>& Values, int32 Index);
+
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static double GetScannedDouble(const TArray<FSiriusStringFormatArgument>& Values, int32 Index);
+
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static bool GetScannedBool(const TArray<FSiriusStringFormatArgument>& Values, int32 Index);
+
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static FString GetScannedString(const TArray<FSiriusStringFormatArgument>& Values, int32 Index);
+
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static FName GetScannedName(const TArray<FSiriusStringFormatArgument>& Values, int32 Index);
+
+	UFUNCTION(BlueprintPure, meta=(BlueprintInternalUseOnly = "true"))
+	static FText GetScannedText(const TArray<FSiriusStringFormatArgument>& Values, int32 Index);
+
+	/* Used for printing by the UK2Node_SiriusPrintStringFormatted, routes log output to the FSiriusDebugOutputSink when it is enabled */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DevelopmentOnly, NotBlueprintThreadSafe))
+	static void PrintString(const UObject* WorldContextObject, const FString& InString, bool bPrintToScreen, bool bPrintToLog, FLinearColor TextColor, float Duration);
+
+	/* Formats and prints in one call for the UK2Node_SiriusPrintStringFormatted, PatternId is the ID of a literal pattern or 0 if the pattern is not known at compile time */
+	UFUNCTION(BlueprintCallable, meta=(BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject", DevelopmentOnly, NotBlueprintThreadSafe))
+	static void PrintStringFormatted(const UObject* WorldContextObject, int64 PatternId, const FString& InPattern, const TArray<FSiriusStringFormatArgument>& InArgs, bool bPrintToScreen, bool bPrintToLog, FLinearColor TextColor, float Duration);
 };
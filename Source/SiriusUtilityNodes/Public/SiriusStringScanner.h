@@ -0,0 +1,33 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SiriusStringFormatPattern.h"
+
+/**
+ * Matches strings against a pattern using the "{Name}" syntax, the inverse of formatting it.
+ *
+ * Literal text must match exactly, and each argument captures the text up to the literal text following it. An argument
+ * followed directly by another argument ends at the first whitespace, the last argument of a pattern captures the rest.
+ */
+class SIRIUSUTILITYNODES_API FSiriusStringScanner
+{
+public:
+	/** Codes of the value types the Scan function converts captured arguments to */
+	static constexpr TCHAR IntTypeCode = TEXT('i');
+	static constexpr TCHAR Int64TypeCode = TEXT('l');
+	static constexpr TCHAR FloatTypeCode = TEXT('f');
+	static constexpr TCHAR DoubleTypeCode = TEXT('d');
+	static constexpr TCHAR BoolTypeCode = TEXT('b');
+	static constexpr TCHAR StringTypeCode = TEXT('s');
+
+	/**
+	 * Matches the whole source string against a pattern, using previously parsed segments of it.
+	 *
+	 * @param OutValues		The captured text of each unique argument, in order of first appearance.
+	 * @return				False if the source doesn't match, an argument used twice captured different text, or the pattern
+	 *						chooses between texts, which can't be inverted.
+	 */
+	static bool Match(FStringView InPattern, TConstArrayView<FSiriusStringFormatSegment> InSegments, FStringView Source, TArray<FStringView>& OutValues);
+};
@@ -0,0 +1,38 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Case sensitive string search, comparing 16 characters at a time with AVX2 on x64 CPUs that support it, 8 at a time
+ * with SSE2 on other x64 CPUs or NEON on ARM, with a scalar fallback on other platforms. Substrings are found by matching their first and last character in bulk, and only
+ * comparing the rest of the substring at positions where both match.
+ */
+class SIRIUSUTILITYNODES_API FSiriusStringSearch
+{
+public:
+	/** Returns the name of the instruction set used, for reports */
+	static const TCHAR* GetImplementationName();
+
+	/** Returns the index of the first occurrence of the character at or after StartIndex, or INDEX_NONE */
+	static int32 FindChar(FStringView Text, TCHAR Char, int32 StartIndex = 0);
+
+	/** Returns the index of the first occurrence of either character at or after StartIndex, or INDEX_NONE */
+	static int32 FindFirstOf(FStringView Text, TCHAR CharA, TCHAR CharB, int32 StartIndex = 0);
+
+	/** Returns the index of the first occurrence of the substring at or after StartIndex, or INDEX_NONE. Empty substrings are never found. */
+	static int32 Find(FStringView Text, FStringView Substring, int32 StartIndex = 0);
+
+	/** Returns the number of non-overlapping occurrences of the substring */
+	static int32 Count(FStringView Text, FStringView Substring);
+
+	/** Returns the text with all non-overlapping occurrences of From replaced by To, allocating the result once */
+	static FString ReplaceAll(FStringView Text, FStringView From, FStringView To);
+
+	/** Splits the text by the delimiter into views of it, so no piece is allocated */
+	static void Split(FStringView Text, FStringView Delimiter, bool bCullEmpty, TArray<FStringView>& OutPieces);
+
+	/** Returns the strings joined by the separator, allocating the result once */
+	static FString Join(TConstArrayView<FString> Strings, FStringView Separator);
+};
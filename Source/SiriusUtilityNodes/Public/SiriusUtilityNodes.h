@@ -5,6 +5,11 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+SIRIUSUTILITYNODES_API DECLARE_LOG_CATEGORY_EXTERN(LogSiriusUtilityNodes, Log, All);
+
 class FSiriusUtilityNodesModule final : public IModuleInterface
 {
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
 };
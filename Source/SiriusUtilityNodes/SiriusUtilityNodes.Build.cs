@@ -22,5 +22,10 @@ public class SiriusUtilityNodes : ModuleRules
 				"Engine"
 			}
 		);
+
+#if UE_5_1_OR_LATER
+		// Used to bind formatted string arguments to field notifications
+		PrivateDependencyModuleNames.Add("FieldNotification");
+#endif
 	}
 }
\ No newline at end of file
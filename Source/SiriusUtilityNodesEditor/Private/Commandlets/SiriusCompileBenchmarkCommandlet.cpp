@@ -0,0 +1,234 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusCompileBenchmarkCommandlet.h"
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_SiriusFormatString.h"
+#include "K2Node_SiriusPrintStringFormatted.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/FileHelper.h"
+#include "UObject/Package.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSiriusCompileBenchmark, Log, All);
+
+namespace SiriusCompileBenchmark
+{
+	struct FResult
+	{
+		FString Name;
+		double CompileSeconds = 0.0;
+		FSiriusExpansionStats ExpansionStats;
+		int32 BytecodeSize = 0;
+	};
+
+	/** Returns a pattern using the given number of arguments */
+	FString MakePattern(const int32 NumArgs)
+	{
+		FString Pattern = TEXT("Benchmark");
+		for (int32 ArgIdx = 0; ArgIdx < NumArgs; ++ArgIdx)
+		{
+			Pattern += FString::Printf(TEXT(" Arg%d={Arg%d}"), ArgIdx, ArgIdx);
+		}
+		return Pattern;
+	}
+
+	/** Creates a call function node in the graph */
+	UK2Node_CallFunction* CreateCallFunctionNode(UEdGraph& Graph, const UFunction* Function)
+	{
+		FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(Graph);
+		UK2Node_CallFunction* Node = NodeCreator.CreateNode(false);
+		Node->SetFromFunction(Function);
+		NodeCreator.Finalize();
+		return Node;
+	}
+
+	/** Sets the pattern of a Sirius node and links all of its argument pins to the given source pin */
+	void SetupFormatNode(UK2Node_SiriusFormatBase& Node, const FString& Pattern, UEdGraphPin* ArgumentSourcePin)
+	{
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+		Schema->TrySetDefaultValue(*Node.GetFormatPin(), Pattern);
+
+		for (const FName& PinName : Node.GetArgumentPinNames())
+		{
+			UEdGraphPin* ArgumentPin = Node.FindArgumentPin(PinName);
+			ArgumentPin->MakeLinkTo(ArgumentSourcePin);
+			Node.PinConnectionListChanged(ArgumentPin);
+		}
+	}
+
+	/**
+	 * Creates a transient Actor Blueprint with a custom event executing the given number of nodes in sequence.
+	 * Format String nodes are executed by printing their result, Print String Formatted nodes directly.
+	 */
+	UBlueprint* CreateBlueprint(const FString& Name, const bool bFormatString, const int32 NumNodes, const int32 NumArgs)
+	{
+		UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), *Name), BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+		UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+		check(Graph);
+
+		FGraphNodeCreator<UK2Node_CustomEvent> EventCreator(*Graph);
+		UK2Node_CustomEvent* EventNode = EventCreator.CreateNode(false);
+		EventNode->CustomFunctionName = TEXT("SiriusCompileBenchmark");
+		EventCreator.Finalize();
+
+		// A single pure node provides the value of all arguments.
+		const UFunction* GameTimeFunction = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, GetGameTimeInSeconds));
+		UEdGraphPin* ArgumentSourcePin = CreateCallFunctionNode(*Graph, GameTimeFunction)->GetReturnValuePin();
+
+		const UFunction* PrintStringFunction = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+		const FString Pattern = MakePattern(NumArgs);
+
+		UEdGraphPin* ThenPin = EventNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+		for (int32 NodeIdx = 0; NodeIdx < NumNodes; ++NodeIdx)
+		{
+			UK2Node* ExecNode = nullptr;
+			if (bFormatString)
+			{
+				FGraphNodeCreator<UK2Node_SiriusFormatString> NodeCreator(*Graph);
+				UK2Node_SiriusFormatString* FormatNode = NodeCreator.CreateNode(false);
+				NodeCreator.Finalize();
+				SetupFormatNode(*FormatNode, Pattern, ArgumentSourcePin);
+
+				UK2Node_CallFunction* PrintNode = CreateCallFunctionNode(*Graph, PrintStringFunction);
+				FormatNode->GetResultPin()->MakeLinkTo(PrintNode->FindPinChecked(TEXT("InString")));
+				ExecNode = PrintNode;
+			}
+			else
+			{
+				FGraphNodeCreator<UK2Node_SiriusPrintStringFormatted> NodeCreator(*Graph);
+				UK2Node_SiriusPrintStringFormatted* PrintNode = NodeCreator.CreateNode(false);
+				NodeCreator.Finalize();
+				SetupFormatNode(*PrintNode, Pattern, ArgumentSourcePin);
+				ExecNode = PrintNode;
+			}
+
+			ThenPin->MakeLinkTo(ExecNode->GetExecPin());
+			ThenPin = ExecNode->GetThenPin();
+		}
+
+		return Blueprint;
+	}
+
+	/** Returns the size of the bytecode of all functions of the class */
+	int32 GetBytecodeSize(const UClass* Class)
+	{
+		int32 Size = 0;
+		for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+		{
+			Size += It->Script.Num();
+		}
+		return Size;
+	}
+
+	/** Compiles the Blueprint and measures its compilation */
+	bool Compile(UBlueprint* Blueprint, FResult& OutResult)
+	{
+		FSiriusExpansionStats::Get().Reset();
+
+		FCompilerResultsLog Results;
+		Results.bSilentMode = true;
+
+		const double StartTime = FPlatformTime::Seconds();
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SkipSave, &Results);
+		OutResult.CompileSeconds += FPlatformTime::Seconds() - StartTime;
+
+		const FSiriusExpansionStats& Stats = FSiriusExpansionStats::Get();
+		OutResult.ExpansionStats.ExpandSeconds += Stats.ExpandSeconds;
+		OutResult.ExpansionStats.NumExpandedNodes = Stats.NumExpandedNodes;
+		OutResult.ExpansionStats.NumIntermediateNodes = Stats.NumIntermediateNodes;
+		OutResult.BytecodeSize = GetBytecodeSize(Blueprint->GeneratedClass);
+
+		if (Results.NumErrors > 0)
+		{
+			for (const TSharedRef<FTokenizedMessage>& Message : Results.Messages)
+			{
+				UE_LOG(LogSiriusCompileBenchmark, Error, TEXT("%s"), *Message->ToText().ToString());
+			}
+			return false;
+		}
+		return true;
+	}
+}
+
+USiriusCompileBenchmarkCommandlet::USiriusCompileBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USiriusCompileBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace SiriusCompileBenchmark;
+
+	int32 NumNodes = 100;
+	int32 NumArgs = 4;
+	int32 NumIterations = 5;
+	FString CsvFilename;
+	FParse::Value(*Params, TEXT("Nodes="), NumNodes);
+	FParse::Value(*Params, TEXT("Args="), NumArgs);
+	FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+	FParse::Value(*Params, TEXT("Csv="), CsvFilename);
+	NumNodes = FMath::Max(NumNodes, 1);
+	NumArgs = FMath::Max(NumArgs, 0);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	TArray<FResult> Results;
+	for (const bool bFormatString : {true, false})
+	{
+		FResult& Result = Results.AddDefaulted_GetRef();
+		Result.Name = bFormatString ? TEXT("FormatString") : TEXT("PrintStringFormatted");
+
+		UBlueprint* Blueprint = CreateBlueprint(Result.Name, bFormatString, NumNodes, NumArgs);
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			if (!Compile(Blueprint, Result))
+			{
+				UE_LOG(LogSiriusCompileBenchmark, Error, TEXT("Failed to compile the %s benchmark Blueprint"), *Result.Name);
+				return 1;
+			}
+		}
+
+		Result.CompileSeconds /= NumIterations;
+		Result.ExpansionStats.ExpandSeconds /= NumIterations;
+	}
+
+	UE_LOG(LogSiriusCompileBenchmark, Display, TEXT("%d nodes with %d arguments, averaged over %d compiles:"), NumNodes, NumArgs, NumIterations);
+	for (const FResult& Result : Results)
+	{
+		UE_LOG(LogSiriusCompileBenchmark, Display, TEXT("  %-20s compile %8.2f ms, expand %8.2f ms, %6d intermediate nodes (%.1f per node), %8d bytes of bytecode"),
+			*Result.Name,
+			Result.CompileSeconds * 1000.0,
+			Result.ExpansionStats.ExpandSeconds * 1000.0,
+			Result.ExpansionStats.NumIntermediateNodes,
+			static_cast<float>(Result.ExpansionStats.NumIntermediateNodes) / NumNodes,
+			Result.BytecodeSize);
+	}
+
+	if (!CsvFilename.IsEmpty())
+	{
+		TArray<FString> Lines;
+		Lines.Add(TEXT("Node,Nodes,Args,CompileMs,ExpandMs,IntermediateNodes,BytecodeSize"));
+		for (const FResult& Result : Results)
+		{
+			Lines.Add(FString::Printf(TEXT("%s,%d,%d,%.3f,%.3f,%d,%d"), *Result.Name, NumNodes, NumArgs, Result.CompileSeconds * 1000.0, Result.ExpansionStats.ExpandSeconds * 1000.0, Result.ExpansionStats.NumIntermediateNodes, Result.BytecodeSize));
+		}
+
+		if (!FFileHelper::SaveStringArrayToFile(Lines, *CsvFilename))
+		{
+			UE_LOG(LogSiriusCompileBenchmark, Error, TEXT("Failed to write results to %s"), *CsvFilename);
+			return 1;
+		}
+	}
+
+	return 0;
+}
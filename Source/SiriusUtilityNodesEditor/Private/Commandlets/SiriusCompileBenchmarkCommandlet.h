@@ -0,0 +1,28 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SiriusCompileBenchmarkCommandlet.generated.h"
+
+/**
+ * Generates transient Blueprints with Format String and Print String Formatted nodes, compiles them and reports the time
+ * spent compiling and expanding the nodes, the number of intermediate nodes and the size of the resulting bytecode:
+ *
+ *   UnrealEditor-Cmd <Project> -run=SiriusCompileBenchmark [-Nodes=100] [-Args=4] [-Iterations=5] [-Csv=<File>]
+ *
+ * Run it with the same arguments against different plugin versions to catch regressions in the node expansion.
+ */
+UCLASS()
+class USiriusCompileBenchmarkCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USiriusCompileBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,112 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusMigrateAppendChainsCommandlet.h"
+
+#include "FileHelpers.h"
+#include "SiriusAppendChainMigration.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSiriusMigrateAppendChains, Log, All);
+
+USiriusMigrateAppendChainsCommandlet::USiriusMigrateAppendChainsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USiriusMigrateAppendChainsCommandlet::Main(const FString& Params)
+{
+	const bool bDryRun = FParse::Param(*Params, TEXT("DryRun"));
+	FString CsvFilename;
+	FParse::Value(*Params, TEXT("Csv="), CsvFilename);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(TEXT("/Game"));
+	Filter.bRecursivePaths = true;
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#else
+	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#endif
+	Filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> BlueprintAssets;
+	AssetRegistry.GetAssets(Filter, BlueprintAssets);
+
+	TArray<FString> CsvLines;
+	CsvLines.Add(TEXT("Blueprint,Chains,NodesRemoved,NodesAdded,CallsSaved"));
+
+	FSiriusAppendChainMigrationStats TotalStats;
+	TArray<FString> FailedBlueprints;
+	for (int32 AssetIdx = 0; AssetIdx < BlueprintAssets.Num(); ++AssetIdx)
+	{
+		UBlueprint* Blueprint = Cast<UBlueprint>(BlueprintAssets[AssetIdx].GetAsset());
+		if (!Blueprint)
+		{
+			continue;
+		}
+
+		TArray<SiriusAppendChainMigration::FChain> Chains;
+		SiriusAppendChainMigration::FindChains(Blueprint, Chains);
+		if (Chains.Num() > 0)
+		{
+			const FSiriusAppendChainMigrationStats Stats = SiriusAppendChainMigration::GetStats(Chains);
+			TotalStats += Stats;
+
+			UE_LOG(LogSiriusMigrateAppendChains, Display, TEXT("%s: %d chains, %d nodes replaced by %d, ~%d calls saved per execution"),
+				*Blueprint->GetPathName(), Stats.NumChains, Stats.NumNodesRemoved, Stats.NumNodesAdded, Stats.NumCallsSaved);
+			CsvLines.Add(FString::Printf(TEXT("%s,%d,%d,%d,%d"), *Blueprint->GetPathName(), Stats.NumChains, Stats.NumNodesRemoved, Stats.NumNodesAdded, Stats.NumCallsSaved));
+
+			if (!bDryRun)
+			{
+				SiriusAppendChainMigration::ApplyChains(Blueprint, Chains);
+				FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+
+				// Never save a Blueprint the migration broke, the package on disk is left as it was.
+				if (Blueprint->Status == BS_Error)
+				{
+					UE_LOG(LogSiriusMigrateAppendChains, Error, TEXT("%s failed to compile after the migration, it was not saved"), *Blueprint->GetPathName());
+					FailedBlueprints.Add(Blueprint->GetPathName());
+				}
+				else if (!UEditorLoadingAndSavingUtils::SavePackages({Blueprint->GetOutermost()}, false))
+				{
+					UE_LOG(LogSiriusMigrateAppendChains, Error, TEXT("Failed to save %s, is it checked out?"), *Blueprint->GetPathName());
+					FailedBlueprints.Add(Blueprint->GetPathName());
+				}
+			}
+		}
+
+		// Keep memory in check on large projects, changed Blueprints have been saved by now.
+		if (AssetIdx % 256 == 255)
+		{
+			CollectGarbage(RF_NoFlags);
+		}
+	}
+
+	UE_LOG(LogSiriusMigrateAppendChains, Display, TEXT("%s %d chains in %d Blueprints, %d nodes replaced by %d, ~%d calls saved per execution"),
+		bDryRun ? TEXT("Found") : TEXT("Migrated"), TotalStats.NumChains, CsvLines.Num() - 1, TotalStats.NumNodesRemoved, TotalStats.NumNodesAdded, TotalStats.NumCallsSaved);
+
+	if (FailedBlueprints.Num() > 0)
+	{
+		UE_LOG(LogSiriusMigrateAppendChains, Error, TEXT("%d Blueprints were not saved:\n%s"), FailedBlueprints.Num(), *FString::Join(FailedBlueprints, TEXT("\n")));
+	}
+
+	if (!CsvFilename.IsEmpty() && !FFileHelper::SaveStringArrayToFile(CsvLines, *CsvFilename))
+	{
+		UE_LOG(LogSiriusMigrateAppendChains, Error, TEXT("Failed to write report to %s"), *CsvFilename);
+		return 1;
+	}
+
+	return FailedBlueprints.Num() > 0 ? 1 : 0;
+}
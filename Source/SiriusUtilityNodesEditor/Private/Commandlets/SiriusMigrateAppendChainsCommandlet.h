@@ -0,0 +1,28 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SiriusMigrateAppendChainsCommandlet.generated.h"
+
+/**
+ * Replaces chains of Append and string conversion nodes by Format String nodes in all Blueprints of the project,
+ * then compiles and saves the changed Blueprints and reports the node count and estimated savings per Blueprint:
+ *
+ *   UnrealEditor-Cmd <Project> -run=SiriusMigrateAppendChains [-DryRun] [-Csv=<File>]
+ *
+ * Use -DryRun to only report what would change.
+ */
+UCLASS()
+class USiriusMigrateAppendChainsCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USiriusMigrateAppendChainsCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,86 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusPatternTableCommandlet.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_SiriusFormatBase.h"
+#include "SiriusPatternTable.h"
+#include "Misc/EngineVersionComparison.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSiriusPatternTable, Log, All);
+
+USiriusPatternTableCommandlet::USiriusPatternTableCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USiriusPatternTableCommandlet::Main(const FString& Params)
+{
+	FString OutputFilename = FSiriusPatternTable::GetDefaultFilename();
+	FParse::Value(*Params, TEXT("Output="), OutputFilename);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(TEXT("/Game"));
+	Filter.bRecursivePaths = true;
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#else
+	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#endif
+	Filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> BlueprintAssets;
+	AssetRegistry.GetAssets(Filter, BlueprintAssets);
+
+	TArray<FString> Patterns;
+	for (int32 AssetIdx = 0; AssetIdx < BlueprintAssets.Num(); ++AssetIdx)
+	{
+		const UBlueprint* Blueprint = Cast<UBlueprint>(BlueprintAssets[AssetIdx].GetAsset());
+		if (!Blueprint)
+		{
+			continue;
+		}
+
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+		for (const UEdGraph* Graph : Graphs)
+		{
+			for (const UEdGraphNode* Node : Graph->Nodes)
+			{
+				// Only literal patterns are known ahead of time, linked ones are parsed at runtime.
+				if (const UK2Node_SiriusFormatBase* FormatNode = Cast<UK2Node_SiriusFormatBase>(Node))
+				{
+					const UEdGraphPin* FormatPin = FormatNode->GetFormatPin();
+					if (FormatPin->LinkedTo.Num() == 0)
+					{
+						Patterns.Add(FormatPin->DefaultValue);
+					}
+				}
+			}
+		}
+
+		// Keep memory in check on large projects
+		if (AssetIdx % 256 == 255)
+		{
+			CollectGarbage(RF_NoFlags);
+		}
+	}
+
+	if (!FSiriusPatternTable::Save(OutputFilename, Patterns))
+	{
+		UE_LOG(LogSiriusPatternTable, Error, TEXT("Failed to write pattern table to %s"), *OutputFilename);
+		return 1;
+	}
+
+	UE_LOG(LogSiriusPatternTable, Display, TEXT("Collected %d literal patterns from %d Blueprints into %s"), Patterns.Num(), BlueprintAssets.Num(), *OutputFilename);
+	return 0;
+}
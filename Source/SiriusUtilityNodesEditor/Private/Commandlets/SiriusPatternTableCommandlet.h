@@ -0,0 +1,29 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SiriusPatternTableCommandlet.generated.h"
+
+/**
+ * Collects the literal patterns of all Format String and Print String Formatted nodes in the project and writes their
+ * pre-parsed segments to the pattern table, which the runtime module maps into memory at startup. Run it before cooking:
+ *
+ *   UnrealEditor-Cmd <Project> -run=SiriusPatternTable [-Output=<File>]
+ *
+ * The table is written to Content/Sirius/PatternTable.bin by default, add Content/Sirius to the project's
+ * "Additional Non-Asset Directories to Package" so it is staged with the build.
+ */
+UCLASS()
+class USiriusPatternTableCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USiriusPatternTableCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
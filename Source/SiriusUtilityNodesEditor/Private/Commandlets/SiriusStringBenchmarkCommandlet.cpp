@@ -0,0 +1,179 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusStringBenchmarkCommandlet.h"
+
+#include "SiriusStringLibrary.h"
+#include "SiriusStringSearch.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Misc/FileHelper.h"
+#include "Misc/StringFormatArg.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSiriusStringBenchmark, Log, All);
+
+namespace SiriusStringBenchmark
+{
+	/** A benchmarked operation, each implementation returns its result as a string so they can be compared */
+	struct FCase
+	{
+		FString Name;
+		TFunction<FString()> Sirius;
+		TFunction<FString()> Engine;
+	};
+
+	struct FResult
+	{
+		FString Name;
+		double SiriusSeconds = 0.0;
+		double EngineSeconds = 0.0;
+	};
+
+	/** Returns the average time of running the function, and its result */
+	double Measure(const TFunction<FString()>& Function, const int32 NumIterations, FString& OutResult)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			OutResult = Function();
+		}
+		return (FPlatformTime::Seconds() - StartTime) / NumIterations;
+	}
+
+	/** Returns lines like the engine writes to its log */
+	TArray<FString> MakeLogLines(const int32 NumLines)
+	{
+		TArray<FString> Lines;
+		Lines.Reserve(NumLines);
+		for (int32 LineIdx = 0; LineIdx < NumLines; ++LineIdx)
+		{
+			Lines.Add(FString::Printf(TEXT("[2022.10.18-12.00.%02d:%03d][%3d]LogTemp: Display: Actor_%d moved to X=%d.000 Y=%d.000 Z=0.000"),
+				LineIdx / 1000 % 60, LineIdx % 1000, LineIdx % 1000, LineIdx % 97, LineIdx, -LineIdx));
+		}
+
+		// Something to find at the very end
+		Lines.Last() += TEXT(" Error: out of bounds");
+		return Lines;
+	}
+}
+
+USiriusStringBenchmarkCommandlet::USiriusStringBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USiriusStringBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace SiriusStringBenchmark;
+
+	int32 NumLines = 10000;
+	int32 NumIterations = 20;
+	FString CsvFilename;
+	FParse::Value(*Params, TEXT("Lines="), NumLines);
+	FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+	FParse::Value(*Params, TEXT("Csv="), CsvFilename);
+	NumLines = FMath::Max(NumLines, 1);
+	NumIterations = FMath::Max(NumIterations, 1);
+
+	const TArray<FString> Lines = MakeLogLines(NumLines);
+	const FString Log = FString::Join(Lines, TEXT("\n"));
+
+	// A long pattern that is only known at runtime, so it is parsed on every call, with few arguments in a lot of text.
+	const FString LongPattern = Log.Replace(TEXT("LogTemp:"), TEXT("{Category}:"), ESearchCase::CaseSensitive);
+	TArray<FSiriusStringFormatArgument> SiriusArgs;
+	FSiriusStringFormatArgument& CategoryArg = SiriusArgs.AddDefaulted_GetRef();
+	CategoryArg.ArgumentName = TEXT("Category");
+	CategoryArg.ArgumentValueType = ESiriusStringFormatArgumentType::String;
+	CategoryArg.ArgumentValue = TEXT("LogSirius");
+	FStringFormatNamedArguments EngineArgs;
+	EngineArgs.Add(CategoryArg.ArgumentName, CategoryArg.ArgumentValue);
+
+	const TArray<FCase> Cases = {
+		{
+			TEXT("Find"),
+			[&Log] { return LexToString(USiriusStringLibrary::FindSubstring(Log, TEXT("Error:"))); },
+			[&Log] { return LexToString(UKismetStringLibrary::FindSubstring(Log, TEXT("Error:"), true)); },
+		},
+		{
+			TEXT("Count"),
+			[&Log] { return LexToString(USiriusStringLibrary::CountSubstring(Log, TEXT("Actor_"))); },
+			[&Log]
+			{
+				// There is no engine function to count, so do what a Blueprint would do.
+				int32 NumMatches = 0;
+				for (int32 Index = UKismetStringLibrary::FindSubstring(Log, TEXT("Actor_"), true); Index != INDEX_NONE; Index = UKismetStringLibrary::FindSubstring(Log, TEXT("Actor_"), true, false, Index + 6))
+				{
+					++NumMatches;
+				}
+				return LexToString(NumMatches);
+			},
+		},
+		{
+			TEXT("ReplaceAll"),
+			[&Log] { return USiriusStringLibrary::ReplaceAll(Log, TEXT("Actor_"), TEXT("Pawn_")); },
+			[&Log] { return UKismetStringLibrary::Replace(Log, TEXT("Actor_"), TEXT("Pawn_"), ESearchCase::CaseSensitive); },
+		},
+		{
+			TEXT("Split"),
+			[&Log] { return LexToString(USiriusStringLibrary::Split(Log, TEXT("\n")).Num()); },
+			[&Log] { return LexToString(UKismetStringLibrary::ParseIntoArray(Log, TEXT("\n")).Num()); },
+		},
+		{
+			TEXT("Join"),
+			[&Lines] { return USiriusStringLibrary::Join(Lines, TEXT("\n")); },
+			[&Lines] { return UKismetStringLibrary::JoinStringArray(Lines, TEXT("\n")); },
+		},
+		{
+			TEXT("FormatLong"),
+			[&LongPattern, &SiriusArgs] { return USiriusStringLibrary::Format(LongPattern, SiriusArgs); },
+			[&LongPattern, &EngineArgs] { return FString::Format(*LongPattern, EngineArgs); },
+		},
+	};
+
+	TArray<FResult> Results;
+	for (const FCase& Case : Cases)
+	{
+		FResult& Result = Results.AddDefaulted_GetRef();
+		Result.Name = Case.Name;
+
+		FString SiriusResult;
+		FString EngineResult;
+		Result.SiriusSeconds = Measure(Case.Sirius, NumIterations, SiriusResult);
+		Result.EngineSeconds = Measure(Case.Engine, NumIterations, EngineResult);
+
+		if (!SiriusResult.Equals(EngineResult, ESearchCase::CaseSensitive))
+		{
+			UE_LOG(LogSiriusStringBenchmark, Error, TEXT("%s returned a different result than the engine: %s vs %s"), *Case.Name, *SiriusResult.Left(64), *EngineResult.Left(64));
+			return 1;
+		}
+	}
+
+	UE_LOG(LogSiriusStringBenchmark, Display, TEXT("%d log lines (%d characters) using %s, averaged over %d iterations:"), NumLines, Log.Len(), FSiriusStringSearch::GetImplementationName(), NumIterations);
+	for (const FResult& Result : Results)
+	{
+		UE_LOG(LogSiriusStringBenchmark, Display, TEXT("  %-12s Sirius %8.3f ms, engine %8.3f ms (%.2fx)"),
+			*Result.Name,
+			Result.SiriusSeconds * 1000.0,
+			Result.EngineSeconds * 1000.0,
+			Result.SiriusSeconds > 0.0 ? Result.EngineSeconds / Result.SiriusSeconds : 0.0);
+	}
+
+	if (!CsvFilename.IsEmpty())
+	{
+		TArray<FString> CsvLines;
+		CsvLines.Add(TEXT("Operation,Implementation,Lines,SiriusMs,EngineMs"));
+		for (const FResult& Result : Results)
+		{
+			CsvLines.Add(FString::Printf(TEXT("%s,%s,%d,%.3f,%.3f"), *Result.Name, FSiriusStringSearch::GetImplementationName(), NumLines, Result.SiriusSeconds * 1000.0, Result.EngineSeconds * 1000.0));
+		}
+
+		if (!FFileHelper::SaveStringArrayToFile(CsvLines, *CsvFilename))
+		{
+			UE_LOG(LogSiriusStringBenchmark, Error, TEXT("Failed to write results to %s"), *CsvFilename);
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,27 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SiriusStringBenchmarkCommandlet.generated.h"
+
+/**
+ * Compares the find, count, replace, split and join functions of the Sirius string library with their Kismet string
+ * library equivalents on a generated log, checking both produce the same results. Formatting a pattern as long as the
+ * log is compared with FString::Format:
+ *
+ *   UnrealEditor-Cmd <Project> -run=SiriusStringBenchmark [-Lines=10000] [-Iterations=20] [-Csv=<File>]
+ */
+UCLASS()
+class USiriusStringBenchmarkCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USiriusStringBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
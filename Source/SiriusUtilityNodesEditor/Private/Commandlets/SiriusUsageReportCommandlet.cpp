@@ -0,0 +1,355 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusUsageReportCommandlet.h"
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_SiriusFormatBase.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Blueprint.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSiriusUsageReport, Log, All);
+
+namespace SiriusUsageReport
+{
+	struct FArgumentUsage
+	{
+		FString Name;
+		FString Type;
+
+		/** Function of the conversion node the expansion generates for the argument, empty if there is none */
+		FString Conversion;
+		bool bLinked = false;
+	};
+
+	struct FNodeUsage
+	{
+		FString Blueprint;
+		FString Graph;
+		FString Node;
+		FString Pattern;
+		bool bLinkedPattern = false;
+		TArray<FArgumentUsage> Arguments;
+	};
+
+	/** Returns the conversion function UK2Node_SiriusFormatBase::ExpandArgumentPins calls for a linked argument pin */
+	FString GetConversionName(const FEdGraphPinType& PinType)
+	{
+		const FName& Category = PinType.PinCategory;
+		if (PinType.IsArray())
+		{
+			return TEXT("FormatArrayArgument");
+		}
+		if (Category == UEdGraphSchema_K2::PC_Byte)
+		{
+			return PinType.PinSubCategoryObject.IsValid() ? TEXT("GetEnumeratorUserFriendlyName") : TEXT("Conv_ByteToInt");
+		}
+		if (Category == UEdGraphSchema_K2::PC_Boolean)
+		{
+			return TEXT("Conv_BoolToString");
+		}
+		if (Category == UEdGraphSchema_K2::PC_Name)
+		{
+			return TEXT("Conv_NameToString");
+		}
+		if (Category == UEdGraphSchema_K2::PC_Text)
+		{
+			return TEXT("Conv_TextToString");
+		}
+		if (Category == UEdGraphSchema_K2::PC_Object)
+		{
+			return TEXT("Conv_ObjectToString");
+		}
+		if (Category == UEdGraphSchema_K2::PC_Struct)
+		{
+			return TEXT("FormatStruct");
+		}
+		return FString();
+	}
+
+	void CollectNodes(const UBlueprint* Blueprint, TArray<FNodeUsage>& OutNodes)
+	{
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+
+		for (const UEdGraph* Graph : Graphs)
+		{
+			for (const UEdGraphNode* GraphNode : Graph->Nodes)
+			{
+				const UK2Node_SiriusFormatBase* Node = Cast<UK2Node_SiriusFormatBase>(GraphNode);
+				if (!Node)
+				{
+					continue;
+				}
+
+				FNodeUsage& Usage = OutNodes.AddDefaulted_GetRef();
+				Usage.Blueprint = Blueprint->GetPathName();
+				Usage.Graph = Graph->GetName();
+				Usage.Node = Node->GetClass()->GetName();
+
+				const UEdGraphPin* FormatPin = Node->GetFormatPin();
+				Usage.bLinkedPattern = FormatPin->LinkedTo.Num() > 0;
+				if (!Usage.bLinkedPattern)
+				{
+					Usage.Pattern = FormatPin->DefaultValue;
+				}
+
+				for (const FName& ArgumentName : Node->GetArgumentPinNames())
+				{
+					const UEdGraphPin* ArgumentPin = Node->FindArgumentPin(ArgumentName);
+					if (!ArgumentPin)
+					{
+						continue;
+					}
+
+					FArgumentUsage& Argument = Usage.Arguments.AddDefaulted_GetRef();
+					Argument.Name = ArgumentName.ToString();
+					Argument.Type = UEdGraphSchema_K2::TypeToText(ArgumentPin->PinType).ToString();
+					Argument.bLinked = ArgumentPin->LinkedTo.Num() > 0;
+					// Output arguments, like those of Scan String, are read rather than converted.
+					if (Argument.bLinked && ArgumentPin->Direction == EGPD_Input)
+					{
+						Argument.Conversion = GetConversionName(ArgumentPin->PinType);
+					}
+				}
+			}
+		}
+	}
+
+	/** Quotes a CSV field if needed */
+	FString EscapeCsv(const FString& Value)
+	{
+		if (Value.Contains(TEXT(",")) || Value.Contains(TEXT("\"")) || Value.Contains(TEXT("\n")))
+		{
+			return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+		}
+		return Value;
+	}
+
+	bool WriteCsv(const FString& Filename, const TArray<FNodeUsage>& Nodes)
+	{
+		TArray<FString> Lines;
+		Lines.Add(TEXT("Blueprint,Graph,Node,Pattern,LinkedPattern,Arguments,UnlinkedArguments,ConversionNodes,ArgumentTypes"));
+
+		for (const FNodeUsage& Node : Nodes)
+		{
+			int32 NumUnlinked = 0;
+			int32 NumConversions = 0;
+			TArray<FString> Types;
+			for (const FArgumentUsage& Argument : Node.Arguments)
+			{
+				NumUnlinked += Argument.bLinked ? 0 : 1;
+				NumConversions += Argument.Conversion.IsEmpty() ? 0 : 1;
+				Types.Add(Argument.bLinked ? Argument.Type : TEXT("Wildcard"));
+			}
+
+			Lines.Add(FString::Printf(TEXT("%s,%s,%s,%s,%s,%d,%d,%d,%s"),
+				*EscapeCsv(Node.Blueprint),
+				*EscapeCsv(Node.Graph),
+				*Node.Node,
+				*EscapeCsv(Node.Pattern),
+				Node.bLinkedPattern ? TEXT("true") : TEXT("false"),
+				Node.Arguments.Num(),
+				NumUnlinked,
+				NumConversions,
+				*EscapeCsv(FString::Join(Types, TEXT(";")))));
+		}
+
+		return FFileHelper::SaveStringArrayToFile(Lines, *Filename);
+	}
+
+	bool WriteJson(const FString& Filename, const TArray<FNodeUsage>& Nodes, const TMap<FString, int32>& PatternCounts, const TMap<FString, int32>& TypeCounts)
+	{
+		TArray<TSharedPtr<FJsonValue>> NodeValues;
+		for (const FNodeUsage& Node : Nodes)
+		{
+			TSharedRef<FJsonObject> NodeObject = MakeShared<FJsonObject>();
+			NodeObject->SetStringField(TEXT("blueprint"), Node.Blueprint);
+			NodeObject->SetStringField(TEXT("graph"), Node.Graph);
+			NodeObject->SetStringField(TEXT("node"), Node.Node);
+			NodeObject->SetBoolField(TEXT("linkedPattern"), Node.bLinkedPattern);
+			NodeObject->SetStringField(TEXT("pattern"), Node.Pattern);
+
+			TArray<TSharedPtr<FJsonValue>> ArgumentValues;
+			for (const FArgumentUsage& Argument : Node.Arguments)
+			{
+				TSharedRef<FJsonObject> ArgumentObject = MakeShared<FJsonObject>();
+				ArgumentObject->SetStringField(TEXT("name"), Argument.Name);
+				ArgumentObject->SetStringField(TEXT("type"), Argument.Type);
+				ArgumentObject->SetBoolField(TEXT("linked"), Argument.bLinked);
+				ArgumentObject->SetStringField(TEXT("conversion"), Argument.Conversion);
+				ArgumentValues.Add(MakeShared<FJsonValueObject>(ArgumentObject));
+			}
+			NodeObject->SetArrayField(TEXT("arguments"), ArgumentValues);
+			NodeValues.Add(MakeShared<FJsonValueObject>(NodeObject));
+		}
+
+		auto MakeCountsObject = [](const TMap<FString, int32>& Counts)
+		{
+			TSharedRef<FJsonObject> CountsObject = MakeShared<FJsonObject>();
+			for (const TPair<FString, int32>& Count : Counts)
+			{
+				CountsObject->SetNumberField(Count.Key, Count.Value);
+			}
+			return CountsObject;
+		};
+
+		const TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+		RootObject->SetArrayField(TEXT("nodes"), NodeValues);
+		RootObject->SetObjectField(TEXT("patterns"), MakeCountsObject(PatternCounts));
+		RootObject->SetObjectField(TEXT("argumentTypes"), MakeCountsObject(TypeCounts));
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		return FJsonSerializer::Serialize(RootObject, Writer) && FFileHelper::SaveStringToFile(Json, *Filename);
+	}
+}
+
+USiriusUsageReportCommandlet::USiriusUsageReportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USiriusUsageReportCommandlet::Main(const FString& Params)
+{
+	using namespace SiriusUsageReport;
+
+	FString CsvFilename;
+	FString JsonFilename;
+	int32 MaxInFlight = 64;
+	FParse::Value(*Params, TEXT("Csv="), CsvFilename);
+	FParse::Value(*Params, TEXT("Json="), JsonFilename);
+	FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+	MaxInFlight = FMath::Max(MaxInFlight, 1);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.PackagePaths.Add(TEXT("/Game"));
+	Filter.bRecursivePaths = true;
+#if !UE_VERSION_OLDER_THAN(5, 1, 0)
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#else
+	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#endif
+	Filter.bRecursiveClasses = true;
+
+	TArray<FAssetData> BlueprintAssets;
+	AssetRegistry.GetAssets(Filter, BlueprintAssets);
+
+	TArray<FNodeUsage> Nodes;
+	TArray<int32> LoadedAssetIndices;
+	int32 NextAssetIdx = 0;
+	int32 NumInFlight = 0;
+	int32 NumProcessed = 0;
+	int32 NumFailed = 0;
+	int32 NumProcessedAtLastGC = 0;
+
+	// Keep a window of packages loading in the background, and scan them on the game thread as they complete.
+	while (NextAssetIdx < BlueprintAssets.Num() || NumInFlight > 0)
+	{
+		while (NumInFlight < MaxInFlight && NextAssetIdx < BlueprintAssets.Num())
+		{
+			const int32 AssetIdx = NextAssetIdx++;
+			++NumInFlight;
+
+			LoadPackageAsync(BlueprintAssets[AssetIdx].PackageName.ToString(), FLoadPackageAsyncDelegate::CreateLambda([&LoadedAssetIndices, &NumInFlight, &NumFailed, AssetIdx](const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type)
+			{
+				--NumInFlight;
+				if (Package)
+				{
+					LoadedAssetIndices.Add(AssetIdx);
+				}
+				else
+				{
+					UE_LOG(LogSiriusUsageReport, Warning, TEXT("Failed to load %s, it is missing from the report"), *PackageName.ToString());
+					++NumFailed;
+				}
+			}));
+		}
+
+		ProcessAsyncLoading(true, false, 0.1f);
+
+		for (const int32 AssetIdx : LoadedAssetIndices)
+		{
+			if (const UBlueprint* Blueprint = Cast<UBlueprint>(BlueprintAssets[AssetIdx].FastGetAsset(false)))
+			{
+				CollectNodes(Blueprint, Nodes);
+				++NumProcessed;
+			}
+			else
+			{
+				UE_LOG(LogSiriusUsageReport, Warning, TEXT("Failed to scan %s, its package holds no Blueprint"), *BlueprintAssets[AssetIdx].PackageName.ToString());
+				++NumFailed;
+			}
+		}
+		LoadedAssetIndices.Reset();
+
+		// Keep memory in check on large projects. Only collect between batches, once every loaded package has been scanned,
+		// packages that are still loading are kept alive by the loader.
+		if (NumProcessed - NumProcessedAtLastGC >= 256)
+		{
+			UE_LOG(LogSiriusUsageReport, Display, TEXT("Scanned %d of %d Blueprints"), NumProcessed, BlueprintAssets.Num());
+			CollectGarbage(RF_NoFlags);
+			NumProcessedAtLastGC = NumProcessed;
+		}
+	}
+
+	TMap<FString, int32> PatternCounts;
+	TMap<FString, int32> TypeCounts;
+	int32 NumArguments = 0;
+	int32 NumUnlinked = 0;
+	int32 NumConversions = 0;
+	for (const FNodeUsage& Node : Nodes)
+	{
+		if (!Node.bLinkedPattern)
+		{
+			PatternCounts.FindOrAdd(Node.Pattern)++;
+		}
+
+		for (const FArgumentUsage& Argument : Node.Arguments)
+		{
+			++NumArguments;
+			NumUnlinked += Argument.bLinked ? 0 : 1;
+			NumConversions += Argument.Conversion.IsEmpty() ? 0 : 1;
+			TypeCounts.FindOrAdd(Argument.bLinked ? Argument.Type : TEXT("Wildcard"))++;
+		}
+	}
+	PatternCounts.ValueSort(TGreater<int32>());
+	TypeCounts.ValueSort(TGreater<int32>());
+
+	UE_LOG(LogSiriusUsageReport, Display, TEXT("Found %d nodes in %d Blueprints using %d distinct literal patterns, %d arguments (%d unlinked) generating %d conversion nodes"),
+		Nodes.Num(), NumProcessed, PatternCounts.Num(), NumArguments, NumUnlinked, NumConversions);
+	if (NumFailed > 0)
+	{
+		UE_LOG(LogSiriusUsageReport, Warning, TEXT("%d Blueprints failed to load or scan, see the warnings above"), NumFailed);
+	}
+	for (const TPair<FString, int32>& TypeCount : TypeCounts)
+	{
+		UE_LOG(LogSiriusUsageReport, Display, TEXT("  %6d x %s"), TypeCount.Value, *TypeCount.Key);
+	}
+
+	if (!CsvFilename.IsEmpty() && !WriteCsv(CsvFilename, Nodes))
+	{
+		UE_LOG(LogSiriusUsageReport, Error, TEXT("Failed to write report to %s"), *CsvFilename);
+		return 1;
+	}
+
+	if (!JsonFilename.IsEmpty() && !WriteJson(JsonFilename, Nodes, PatternCounts, TypeCounts))
+	{
+		UE_LOG(LogSiriusUsageReport, Error, TEXT("Failed to write report to %s"), *JsonFilename);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,28 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SiriusUsageReportCommandlet.generated.h"
+
+/**
+ * Reports how Format String and Print String Formatted nodes are used throughout the project: their patterns, the types
+ * of their arguments, unlinked (wildcard) argument pins and the conversion nodes their expansion generates:
+ *
+ *   UnrealEditor-Cmd <Project> -run=SiriusUsageReport [-Csv=<File>] [-Json=<File>] [-MaxInFlight=64]
+ *
+ * Blueprints are loaded asynchronously, keeping up to MaxInFlight package loads in flight.
+ */
+UCLASS()
+class USiriusUsageReportCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USiriusUsageReportCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -5,7 +5,6 @@
 #include "Widgets/SWidget.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
 #include "Widgets/SBoxPanel.h"
-#include "UObject/Package.h"
 #if ENGINE_MAJOR_VERSION < 5 || ENGINE_MINOR_VERSION < 1 // 5.0 and earlier
 #include "EditorStyleSet.h"
 #endif
@@ -15,6 +14,8 @@
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Input/SButton.h"
+#include "K2Node_SiriusFormatName.h"
+#include "K2Node_SiriusFormatStringAsync.h"
 #include "K2Node_SiriusFormatString.h"
 #include "DetailLayoutBuilder.h"
 #include "DetailWidgetRow.h"
@@ -30,9 +31,16 @@ void FFormatStringDetails::CustomizeDetails(IDetailLayoutBuilder& DetailLayout)
 
 	if (Objects.Num() == 1)
 	{
-		TargetNode = CastChecked<UK2Node_SiriusFormatString>(Objects[0].Get());
+		UK2Node_SiriusFormatString* Node = CastChecked<UK2Node_SiriusFormatString>(Objects[0].Get());
+		TargetNode = Node;
 		TSharedRef<IPropertyHandle> PropertyHandle = DetailLayout.GetProperty(FName("PinNames"), UK2Node_SiriusFormatString::StaticClass());
 
+		// Format Name always remembers its results, Format String Async outputs each result once.
+		if (Node->IsA<UK2Node_SiriusFormatName>() || Node->IsA<UK2Node_SiriusFormatStringAsync>())
+		{
+			DetailLayout.HideProperty(DetailLayout.GetProperty(FName("bCacheResult"), UK2Node_SiriusFormatString::StaticClass()));
+		}
+
 		IDetailCategoryBuilder& InputsCategory = DetailLayout.EditCategory("Arguments", LOCTEXT("DetailsArguments", "Arguments"));
 
 		InputsCategory.AddCustomRow(LOCTEXT("FunctionNewInputArg", "New"))
@@ -47,69 +55,57 @@ void FFormatStringDetails::CustomizeDetails(IDetailLayoutBuilder& DetailLayout)
 			]
 		];
 
-		Layout = MakeShareable(new FFormatStringLayout(TargetNode));
+		Layout = MakeShareable(new FFormatStringLayout(Node));
 		InputsCategory.AddCustomBuilder(Layout.ToSharedRef());
-	}
 
-	UPackage::PackageDirtyStateChangedEvent.AddSP(this, &FFormatStringDetails::OnEditorPackageModified);
+		// Only changes of this node are relevant, unrelated edits shouldn't rebuild the panel.
+		ArgumentsChangedHandle = Node->OnArgumentsChanged().AddSP(this, &FFormatStringDetails::OnTargetNodeArgumentsChanged);
+	}
 }
 
 FFormatStringDetails::~FFormatStringDetails()
 {
-	UPackage::PackageDirtyStateChangedEvent.RemoveAll(this);
-}
-
-void FFormatStringDetails::OnForceRefresh() const
-{
-	Layout->Refresh();
+	if (UK2Node_SiriusFormatString* Node = TargetNode.Get())
+	{
+		Node->OnArgumentsChanged().Remove(ArgumentsChangedHandle);
+	}
 }
 
 FReply FFormatStringDetails::OnAddNewArgument() const
 {
 	TargetNode->AddArgumentPin();
-	OnForceRefresh();
 	return FReply::Handled();
 }
 
-// ReSharper disable once CppParameterMayBeConstPtrOrRef
-void FFormatStringDetails::OnEditorPackageModified(UPackage* Package) const
+void FFormatStringDetails::OnTargetNodeArgumentsChanged() const
 {
-	if (TargetNode &&
-		Package &&
-		Package->IsDirty() &&
-		Package == TargetNode->GetOutermost() &&
-		(!Layout.IsValid() || !Layout->CausedChange()))
+	if (Layout.IsValid())
 	{
-		OnForceRefresh();
+		Layout->OnArgumentsChanged();
 	}
 }
 
 bool FFormatStringDetails::CanEditArguments() const
 {
-	return TargetNode->CanEditArguments();
+	return TargetNode.IsValid() && TargetNode->CanEditArguments();
 }
 
-void FFormatStringLayout::GenerateChildContent(IDetailChildrenBuilder& ChildrenBuilder)
+void FFormatStringLayout::OnArgumentsChanged() const
 {
-	Children.Empty();
-	for (int32 ArgIdx = 0; ArgIdx < TargetNode->GetArgumentCount(); ++ArgIdx)
+	if (TargetNode->GetArgumentCount() != NumArgumentRows)
 	{
-		TSharedRef<FFormatStringArgumentLayout> ArgumentIndexLayout = MakeShareable(new FFormatStringArgumentLayout(TargetNode, ArgIdx));
-		ChildrenBuilder.AddCustomBuilder(ArgumentIndexLayout);
-		Children.Add(ArgumentIndexLayout);
+		// ReSharper disable once CppExpressionWithoutSideEffects
+		OnRebuildChildren.ExecuteIfBound();
 	}
 }
 
-bool FFormatStringLayout::CausedChange() const
+void FFormatStringLayout::GenerateChildContent(IDetailChildrenBuilder& ChildrenBuilder)
 {
-	for (const auto Child : Children)
+	NumArgumentRows = TargetNode->GetArgumentCount();
+	for (int32 ArgIdx = 0; ArgIdx < NumArgumentRows; ++ArgIdx)
 	{
-		if (Child.IsValid() && Child.Pin()->CausedChange())
-		{
-			return true;
-		}
+		ChildrenBuilder.AddCustomBuilder(MakeShareable(new FFormatStringArgumentLayout(TargetNode, ArgIdx)));
 	}
-	return false;
 }
 
 void FFormatStringArgumentLayout::GenerateHeaderRowContent(FDetailWidgetRow& NodeRow)
@@ -205,28 +201,10 @@ bool FFormatStringArgumentLayout::CanEditArguments() const
 	return TargetNode->CanEditArguments();
 }
 
-struct FScopeTrue
-{
-	bool& bRef;
-
-	explicit FScopeTrue(bool& bInRef) : bRef(bInRef)
-	{
-		ensure(!bRef);
-		bRef = true;
-	}
-
-	~FScopeTrue()
-	{
-		ensure(bRef);
-		bRef = false;
-	}
-};
-
 void FFormatStringArgumentLayout::OnArgumentNameCommitted(const FText& NewText, ETextCommit::Type /*InTextCommit*/)
 {
 	if (IsValidArgumentName(NewText))
 	{
-		FScopeTrue ScopeTrue(bCausedChange);
 		TargetNode->SetArgumentName(ArgumentIndex, *NewText.ToString());
 	}
 	ArgumentNameWidget.Pin()->SetError(FString());
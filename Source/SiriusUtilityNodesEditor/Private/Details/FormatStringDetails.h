@@ -19,13 +19,10 @@ class FFormatStringArgumentLayout final : public IDetailCustomNodeBuilder, publi
 public:
 	FFormatStringArgumentLayout(UK2Node_SiriusFormatString* InTargetNode, int32 InArgumentIndex)
 		: TargetNode(InTargetNode),
-		  ArgumentIndex(InArgumentIndex),
-		  bCausedChange(false)
+		  ArgumentIndex(InArgumentIndex)
 	{
 	}
 
-	bool CausedChange() const { return bCausedChange; }
-
 private:
 	/** IDetailCustomNodeBuilder Interface*/
 	virtual void SetOnRebuildChildren(FSimpleDelegate InOnRegenerateChildren) override
@@ -82,8 +79,6 @@ private:
 
 	/** The argument's name widget, used for setting a argument's name */
 	TWeakPtr<SEditableTextBox> ArgumentNameWidget;
-
-	bool bCausedChange;
 };
 
 /** Custom struct for each group of arguments in the function editing details */
@@ -91,17 +86,13 @@ class FFormatStringLayout final : public IDetailCustomNodeBuilder, public TShare
 {
 public:
 	explicit FFormatStringLayout(UK2Node_SiriusFormatString* InTargetNode)
-		: TargetNode(InTargetNode)
-	{
-	}
-
-	void Refresh() const
+		: TargetNode(InTargetNode),
+		  NumArgumentRows(0)
 	{
-		// ReSharper disable once CppExpressionWithoutSideEffects
-		OnRebuildChildren.ExecuteIfBound();
 	}
 
-	bool CausedChange() const;
+	/** Rebuilds the argument rows if arguments were added or removed, the rows read the argument names themselves */
+	void OnArgumentsChanged() const;
 
 private:
 	/** IDetailCustomNodeBuilder Interface*/
@@ -126,7 +117,8 @@ private:
 	/** The target node that this argument is on */
 	UK2Node_SiriusFormatString* TargetNode;
 
-	TArray<TWeakPtr<FFormatStringArgumentLayout>> Children;
+	/** Number of argument rows generated last time */
+	int32 NumArgumentRows;
 };
 
 /** Details customization for the "Format String" node */
@@ -139,28 +131,22 @@ public:
 		return MakeShareable(new FFormatStringDetails);
 	}
 
-	FFormatStringDetails() : TargetNode(nullptr)
-	{
-	}
-
 	virtual ~FFormatStringDetails() override;
 
 	/** IDetailCustomization interface */
 	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailLayout) override;
 
-	/** Forces a refresh on the details customization */
-	void OnForceRefresh() const;
-
 private:
 	/** Handles new argument request */
 	FReply OnAddNewArgument() const;
 
-	/** Callback whenever a package is marked dirty, will refresh the node being represented by this details customization */
-	void OnEditorPackageModified(UPackage* Package) const;
+	/** Callback whenever the arguments of the target node changed, updates the argument rows */
+	void OnTargetNodeArgumentsChanged() const;
 
 	bool CanEditArguments() const;
 
 	TSharedPtr<FFormatStringLayout> Layout;
 	/** The target node that this argument is on */
-	UK2Node_SiriusFormatString* TargetNode;
+	TWeakObjectPtr<UK2Node_SiriusFormatString> TargetNode;
+	FDelegateHandle ArgumentsChangedHandle;
 };
@@ -0,0 +1,119 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "K2Node_SiriusAppendFormatted.h"
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "KismetCompiler.h"
+#include "SiriusPatternTable.h"
+#include "SiriusStringBuilder.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_SiriusAppendFormatted"
+
+const FName UK2Node_SiriusAppendFormatted::ExecutePinName = UEdGraphSchema_K2::PN_Execute;
+const FName UK2Node_SiriusAppendFormatted::ThenPinName = UEdGraphSchema_K2::PN_Then;
+const FName UK2Node_SiriusAppendFormatted::BuilderPinName = TEXT("Builder");
+const FName UK2Node_SiriusAppendFormatted::FormatPinName = TEXT("Format");
+
+UK2Node_SiriusAppendFormatted::UK2Node_SiriusAppendFormatted()
+{
+	NodeTooltip = LOCTEXT("NodeTooltip", "Appends a formatted string to a String Builder.\n  \u2022 Use {} to denote format arguments.\n  \u2022 Choices like {Count|plural(one=item,other=items)} only format the chosen text, but every argument pin is still evaluated and converted.\n  \u2022 Argument types may be Byte, Enum, Integer, Integer64, Float, Double, Text, String, Name, Boolean, Object, Struct or an array of those.");
+}
+
+void UK2Node_SiriusAppendFormatted::AllocateDefaultPins()
+{
+	Super::AllocateDefaultPins();
+
+	// Execution pins
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, ExecutePinName);
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, ThenPinName);
+
+	// The builder is appended to in place, so it has to be passed by reference.
+	FCreatePinParams BuilderPinParams;
+	BuilderPinParams.bIsReference = true;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Struct, FSiriusStringBuilder::StaticStruct(), BuilderPinName, BuilderPinParams);
+
+	// Format pins
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_String, FormatPinName);
+	for (const FName& PinName : PinNames)
+	{
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, PinName);
+	}
+}
+
+FText UK2Node_SiriusAppendFormatted::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("NodeTitle", "Append Formatted (Sirius)");
+}
+
+FText UK2Node_SiriusAppendFormatted::GetPinDisplayName(const UEdGraphPin* Pin) const
+{
+	// Don't show the names of the execution pins.
+	if (Pin != GetExecutePin() && Pin != GetThenPin())
+	{
+		return FText::FromName(Pin->PinName);
+	}
+
+	return FText::GetEmpty();
+}
+
+void UK2Node_SiriusAppendFormatted::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Modify();
+
+	// Potentially update an argument pin type
+	SynchronizeArgumentPinType(Pin);
+}
+
+void UK2Node_SiriusAppendFormatted::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	const FScopedExpansionStats ExpansionStats(SourceGraph);
+
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	// Format straight into the builder, so the formatted string never has to pass through the Blueprint VM.
+	UK2Node_CallFunction* AppendFormattedNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	const UFunction* Function = USiriusStringBuilderLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(USiriusStringBuilderLibrary, AppendFormatted));
+	AppendFormattedNode->SetFromFunction(Function);
+	AppendFormattedNode->AllocateDefaultPins();
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(AppendFormattedNode, this);
+
+	if (!ExpandArgumentPins(CompilerContext, SourceGraph, AppendFormattedNode->FindPinChecked(TEXT("InArgs"))))
+	{
+		return;
+	}
+
+	// Literal patterns are known now, so they can be referenced by ID and don't have to be parsed at runtime.
+	UEdGraphPin* FormatPin = GetFormatPin();
+	if (FormatPin->LinkedTo.Num() == 0)
+	{
+		const int64 PatternId = FSiriusPatternTable::GetPatternId(FormatPin->DefaultValue);
+		CompilerContext.GetSchema()->TrySetDefaultValue(*AppendFormattedNode->FindPinChecked(TEXT("PatternId")), LexToString(PatternId));
+	}
+
+	// Link pins with the append function node.
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *AppendFormattedNode->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetBuilderPin(), *AppendFormattedNode->FindPinChecked(TEXT("Builder")));
+	CompilerContext.MovePinLinksToIntermediate(*FormatPin, *AppendFormattedNode->FindPinChecked(TEXT("InPattern")));
+	CompilerContext.MovePinLinksToIntermediate(*GetThenPin(), *AppendFormattedNode->GetThenPin());
+
+	// Final step, break all links to this node as we've finished expanding it.
+	BreakAllNodeLinks();
+}
+
+UEdGraphPin* UK2Node_SiriusAppendFormatted::GetExecutePin() const
+{
+	return FindPinChecked(ExecutePinName, EGPD_Input);
+}
+
+UEdGraphPin* UK2Node_SiriusAppendFormatted::GetThenPin() const
+{
+	return FindPinChecked(ThenPinName, EGPD_Output);
+}
+
+UEdGraphPin* UK2Node_SiriusAppendFormatted::GetBuilderPin() const
+{
+	return FindPinChecked(BuilderPinName, EGPD_Input);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,599 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "K2Node_SiriusFormatBase.h"
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EditorCategoryUtils.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_MakeStruct.h"
+#include "KismetCompiler.h"
+#include "SiriusK2NodeUtils.h"
+#include "SiriusStringLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetNodeHelperLibrary.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Kismet/KismetTextLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_SiriusFormatBase"
+
+static TAutoConsoleVariable<bool> CVarSiriusBatchPinNotifications(
+	TEXT("Sirius.BatchPinNotifications"),
+	true,
+	TEXT("When disabled, format nodes notify the graph for every argument pin whose type changes while they are reconstructed. Useful to measure the effect of batching."),
+	ECVF_Default);
+
+FSiriusExpansionStats& FSiriusExpansionStats::Get()
+{
+	static FSiriusExpansionStats Stats;
+	return Stats;
+}
+
+void UK2Node_SiriusFormatBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_SiriusFormatBase, ArraySeparator) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UK2Node_SiriusFormatBase, MaxArrayElements))
+	{
+		// Only affects the expansion, so a recompile is enough
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+}
+
+void UK2Node_SiriusFormatBase::PostEditUndo()
+{
+	// Undo restores the pin list as a whole
+	InvalidateArgumentPinIndex();
+
+	Super::PostEditUndo();
+
+	BroadcastArgumentsChanged();
+}
+
+void UK2Node_SiriusFormatBase::AllocateDefaultPins()
+{
+	InvalidateArgumentPinIndex();
+
+	Super::AllocateDefaultPins();
+}
+
+void UK2Node_SiriusFormatBase::PinDefaultValueChanged(UEdGraphPin* Pin)
+{
+	// Detect if the format pin has changed.
+	const UEdGraphPin* FormatPin = GetFormatPin();
+	if (Pin == FormatPin && FormatPin->LinkedTo.Num() == 0)
+	{
+		TArray<FName> NewPinNames;
+		SiriusK2NodeUtils::GetPatternArgumentNames(FormatPin->DefaultValue, NewPinNames);
+
+		// Most edits only change literal text, which doesn't require touching any pin.
+		if (SiriusK2NodeUtils::AreNamesEqual(NewPinNames, PinNames))
+		{
+			return;
+		}
+
+		UpdateArgumentPinIndex();
+
+		SiriusK2NodeUtils::FNameSet NewNameSet;
+		NewNameSet.Append(NewPinNames);
+
+		// Destroy argument pins whose arguments were removed.
+		for (auto It = ArgumentPinIndex.CreateIterator(); It; ++It)
+		{
+			if (!NewNameSet.Contains(It.Key()))
+			{
+				UEdGraphPin* RemovedPin = It.Value();
+				RemovedPin->MarkAsGarbage();
+				Pins.Remove(RemovedPin);
+				It.RemoveCurrent();
+			}
+		}
+
+		// Create argument pins for arguments that were added.
+		for (const FName& NewPinName : NewPinNames)
+		{
+			if (!ArgumentPinIndex.Contains(NewPinName))
+			{
+				CreateIndexedArgumentPin(NewPinName);
+			}
+		}
+
+		PinNames = MoveTemp(NewPinNames);
+		BroadcastArgumentsChanged();
+
+		// Notify graph that something changed.
+		GetGraph()->NotifyGraphChanged();
+	}
+}
+
+void UK2Node_SiriusFormatBase::PinTypeChanged(UEdGraphPin* Pin)
+{
+	// Potentially update an argument pin type
+	SynchronizeArgumentPinType(Pin);
+
+	Super::PinTypeChanged(Pin);
+}
+
+FText UK2Node_SiriusFormatBase::GetTooltipText() const
+{
+	return NodeTooltip;
+}
+
+void UK2Node_SiriusFormatBase::PostReconstructNode()
+{
+	Super::PostReconstructNode();
+
+	if (!IsTemplate())
+	{
+		// Make sure we're not dealing with a menu node
+		if (GetSchema())
+		{
+			const FScopedNotificationBatch NotificationBatch(*this);
+			for (UEdGraphPin* CurrentPin : Pins)
+			{
+				// Potentially update an argument pin type
+				SynchronizeArgumentPinType(CurrentPin);
+			}
+		}
+	}
+}
+
+bool UK2Node_SiriusFormatBase::IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (FindArgumentPin(MyPin->PinName) == MyPin)
+	{
+		const FName& OtherPinCategory = OtherPin->PinType.PinCategory;
+
+		// Arrays are formatted element by element, sets and maps are not supported.
+		const bool bIsValidContainer = !OtherPin->PinType.IsSet() && !OtherPin->PinType.IsMap();
+
+		bool bIsValidType = false;
+		if (bIsValidContainer && (OtherPinCategory == UEdGraphSchema_K2::PC_Int ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Int64 ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Real ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Text ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Byte ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Boolean ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_String ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Name ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Object ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Struct ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Wildcard))
+		{
+			bIsValidType = true;
+		}
+
+		if (!bIsValidType)
+		{
+			OutReason = LOCTEXT("Error_InvalidArgumentType", "Format arguments may only be Byte, Enum, Integer, Integer64, Float, Double, Text, String, Name, Boolean, Object, Struct, Wildcard or an array of those.").ToString();
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_SiriusFormatBase::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	const UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_SiriusFormatBase::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::String);
+}
+
+bool UK2Node_SiriusFormatBase::ExpandArgumentPins(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UEdGraphPin* ArgsPin)
+{
+	// Create a "Make Array" node to compile the list of arguments into an array for the function being called
+	UK2Node_MakeArray* MakeArrayNode = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
+	MakeArrayNode->AllocateDefaultPins();
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(MakeArrayNode, this);
+
+	UEdGraphPin* ArrayOut = MakeArrayNode->GetOutputPin();
+
+	// Connect the output of the "Make Array" pin to the function's arguments pin
+	ArrayOut->MakeLinkTo(ArgsPin);
+
+	// This will set the "Make Array" node's type, only works if one pin is connected.
+	MakeArrayNode->PinConnectionListChanged(ArrayOut);
+
+	// Links the output of the node building an argument to the next input pin of the "Make Array" node.
+	auto LinkToMakeArray = [MakeArrayNode](UEdGraphPin* ArgumentOutputPin, const int32 ArgIdx)
+	{
+		// The "Make Array" node already has one pin available, so don't create one for ArgIdx == 0
+		if (ArgIdx > 0)
+		{
+			MakeArrayNode->AddInputPin();
+		}
+
+		// Input pins are appended to the "Make Array" node, so the last pin is the one for this argument.
+		UEdGraphPin* InputPin = MakeArrayNode->Pins.Last();
+		check(InputPin->Direction == EGPD_Input);
+		ArgumentOutputPin->MakeLinkTo(InputPin);
+	};
+
+	// For each argument, we will need to add in a "Make Struct" node.
+	for (int32 ArgIdx = 0; ArgIdx < PinNames.Num(); ++ArgIdx)
+	{
+		UEdGraphPin* ArgumentPin = FindArgumentPin(PinNames[ArgIdx]);
+
+		if (ArgumentPin->LinkedTo.Num() > 0 && ArgumentPin->PinType.IsArray())
+		{
+			// Format all elements in a single call, straight into the argument struct rather than through a "Make Struct" node.
+			UK2Node_CallFunction* CallFormatArrayFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+			CallFormatArrayFunction->SetFromFunction(USiriusStringLibrary::StaticClass()->FindFunctionByName(GET_MEMBER_NAME_CHECKED(USiriusStringLibrary, FormatArrayArgument)));
+			CallFormatArrayFunction->AllocateDefaultPins();
+			CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFormatArrayFunction, this);
+
+			// The array pin is a wildcard, it takes the type of the argument.
+			UEdGraphPin* ArrayPin = CallFormatArrayFunction->FindPinChecked(TEXT("InArray"));
+			ArrayPin->PinType = ArgumentPin->PinType;
+			CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *ArrayPin);
+
+			const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+			Schema->TrySetDefaultValue(*CallFormatArrayFunction->FindPinChecked(TEXT("ArgumentName")), ArgumentPin->PinName.ToString());
+			Schema->TrySetDefaultValue(*CallFormatArrayFunction->FindPinChecked(TEXT("Separator")), ArraySeparator);
+			Schema->TrySetDefaultValue(*CallFormatArrayFunction->FindPinChecked(TEXT("MaxElements")), FString::FromInt(MaxArrayElements));
+
+			LinkToMakeArray(CallFormatArrayFunction->GetReturnValuePin(), ArgIdx);
+			continue;
+		}
+
+		static UScriptStruct* FormatArgumentDataStruct = FindObjectChecked<UScriptStruct>(FindObjectChecked<UPackage>(nullptr, TEXT("/Script/SiriusUtilityNodes"), true), TEXT("SiriusStringFormatArgument"), true);
+
+		// Spawn a "Make Struct" node to create the struct needed for formatting the text.
+		UK2Node_MakeStruct* MakeFormatArgumentDataStruct = CompilerContext.SpawnIntermediateNode<UK2Node_MakeStruct>(this, SourceGraph);
+		MakeFormatArgumentDataStruct->StructType = FormatArgumentDataStruct;
+		MakeFormatArgumentDataStruct->AllocateDefaultPins();
+		MakeFormatArgumentDataStruct->bMadeAfterOverridePinRemoval = true;
+		CompilerContext.MessageLog.NotifyIntermediateObjectCreation(MakeFormatArgumentDataStruct, this);
+
+		// Set the struct's "ArgumentName" pin literal to be the argument pin's name.
+		MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentName)), ArgumentPin->PinName.ToString());
+
+		UEdGraphPin* ArgumentTypePin = MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValueType));
+
+		// Move the connection of the argument pin to the correct argument value pin, and also set the correct argument type based on the pin that was hooked up.
+		if (ArgumentPin->LinkedTo.Num() > 0)
+		{
+			const FName& ArgumentPinCategory = ArgumentPin->PinType.PinCategory;
+
+			// Adds an implicit conversion node to this argument based on its function and pin name
+			auto AddConversionNode = [&](const UFunction* ConversionFunction, const TCHAR* PinName)
+			{
+				// Set the default value if there was something passed in, or default to "String"
+				MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("String"));
+
+				// Spawn conversion node based on the given function name
+				UK2Node_CallFunction* ToTextFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+				ToTextFunction->SetFromFunction(ConversionFunction);
+				ToTextFunction->AllocateDefaultPins();
+				CompilerContext.MessageLog.NotifyIntermediateObjectCreation(ToTextFunction, this);
+
+				CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *ToTextFunction->FindPinChecked(PinName));
+
+				ToTextFunction->FindPinChecked(UEdGraphSchema_K2::PN_ReturnValue)->MakeLinkTo(MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValue)));
+			};
+
+			if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Int)
+			{
+				MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("Int"));
+				CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValueInt)));
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Int64)
+			{
+				MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("Int64"));
+				CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValueInt64)));
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Real)
+			{
+				if (ArgumentPin->PinType.PinSubCategory == UEdGraphSchema_K2::PC_Float)
+				{
+					MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("Float"));
+					CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_STRING_CHECKED(FSiriusStringFormatArgument, ArgumentValueFloat)));
+				}
+				else if (ArgumentPin->PinType.PinSubCategory == UEdGraphSchema_K2::PC_Double)
+				{
+					MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("Double"));
+					CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_STRING_CHECKED(FSiriusStringFormatArgument, ArgumentValueDouble)));
+				}
+				else
+				{
+					check(false);
+				}
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_String)
+			{
+				MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("String"));
+				CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValue)));
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Byte)
+			{
+				if (ArgumentPin->PinType.PinSubCategoryObject.IsValid())
+				{
+					UEnum* Enum = Cast<UEnum>(ArgumentPin->PinType.PinSubCategoryObject.Get());
+					if (!Enum)
+					{
+						CompilerContext.MessageLog.Error(*LOCTEXT("Error_MustHaveValidEnum", "@@ must have a valid enum defined").ToString(), this);
+						return false;
+					}
+
+					const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+
+					// Convert the enum to a friendly display string.
+					UK2Node_CallFunction* CallEnumToStringFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+					CallEnumToStringFunction->SetFromFunction(UKismetNodeHelperLibrary::StaticClass()->FindFunctionByName(GET_MEMBER_NAME_CHECKED(UKismetNodeHelperLibrary, GetEnumeratorUserFriendlyName)));
+					CallEnumToStringFunction->AllocateDefaultPins();
+					check(CallEnumToStringFunction->IsNodePure());
+					CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallEnumToStringFunction, this);
+
+					// Set the enum pin to the enum type we're converting.
+					UEdGraphPin* EnumPin = CallEnumToStringFunction->FindPinChecked(TEXT("Enum"));
+					Schema->TrySetDefaultObject(*EnumPin, Enum);
+					check(EnumPin->DefaultObject == Enum);
+
+					// Set the enum value pin next.
+					UEdGraphPin* IndexPin = CallEnumToStringFunction->FindPinChecked(TEXT("EnumeratorValue"));
+					check(EGPD_Input == IndexPin->Direction && UEdGraphSchema_K2::PC_Byte == IndexPin->PinType.PinCategory);
+					CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *IndexPin);
+
+					// Connect the string output pin to the argument value pin.
+					MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("String"));
+					CallEnumToStringFunction->FindPinChecked(UEdGraphSchema_K2::PN_ReturnValue)->MakeLinkTo(MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValue)));
+				}
+				else
+				{
+					MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("Int"));
+
+					// Need a manual cast from byte -> int
+					UK2Node_CallFunction* CallByteToIntFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+					CallByteToIntFunction->SetFromFunction(UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_MEMBER_NAME_CHECKED(UKismetMathLibrary, Conv_ByteToInt)));
+					CallByteToIntFunction->AllocateDefaultPins();
+					CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallByteToIntFunction, this);
+
+					// Move the byte output pin to the input pin of the conversion node
+					CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *CallByteToIntFunction->FindPinChecked(TEXT("InByte")));
+
+					// Connect the int output pin to the argument value
+					CallByteToIntFunction->FindPinChecked(UEdGraphSchema_K2::PN_ReturnValue)->MakeLinkTo(MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValueInt)));
+				}
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Boolean)
+			{
+				AddConversionNode(UKismetStringLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED_OneParam(UKismetStringLibrary, Conv_BoolToString, bool)), TEXT("InBool"));
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Name)
+			{
+				AddConversionNode(UKismetStringLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED_OneParam(UKismetStringLibrary, Conv_NameToString, FName)), TEXT("InName"));
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Text)
+			{
+				AddConversionNode(UKismetTextLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED_OneParam(UKismetTextLibrary, Conv_TextToString, FText)), TEXT("InText"));
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Object)
+			{
+				AddConversionNode(UKismetStringLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED_OneParam(UKismetStringLibrary, Conv_ObjectToString, UObject*)), TEXT("InObj"));
+			}
+			else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Struct)
+			{
+				MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("String"));
+
+				// Walks the struct with a formatter cached per struct type, instead of exporting it as text.
+				UK2Node_CallFunction* CallFormatStructFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+				CallFormatStructFunction->SetFromFunction(USiriusStringLibrary::StaticClass()->FindFunctionByName(GET_MEMBER_NAME_CHECKED(USiriusStringLibrary, FormatStruct)));
+				CallFormatStructFunction->AllocateDefaultPins();
+				CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFormatStructFunction, this);
+
+				// The struct pin is a wildcard, it takes the type of the argument.
+				UEdGraphPin* StructPin = CallFormatStructFunction->FindPinChecked(TEXT("InStruct"));
+				StructPin->PinType = ArgumentPin->PinType;
+				CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *StructPin);
+
+				CallFormatStructFunction->GetReturnValuePin()->MakeLinkTo(MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValue)));
+			}
+			else
+			{
+				// Unexpected pin type!
+				CompilerContext.MessageLog.Error(*FText::Format(LOCTEXT("Error_UnexpectedPinType", "Pin '{0}' has an unexpected type: {1}"), FText::FromName(PinNames[ArgIdx]), FText::FromName(ArgumentPinCategory)).ToString());
+			}
+		}
+		else
+		{
+			// No connected pin - just default to an empty string
+			MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultValue(*ArgumentTypePin, TEXT("String"));
+			MakeFormatArgumentDataStruct->GetSchema()->TrySetDefaultText(*MakeFormatArgumentDataStruct->FindPinChecked(GET_MEMBER_NAME_CHECKED(FSiriusStringFormatArgument, ArgumentValue)), FText::GetEmpty());
+		}
+
+		// Find the output for the pin's "Make Struct" node and link it to the corresponding pin on the "Make Array" node.
+		for (UEdGraphPin* Pin : MakeFormatArgumentDataStruct->Pins)
+		{
+			if (Pin && Pin->Direction == EGPD_Output)
+			{
+				LinkToMakeArray(Pin, ArgIdx);
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+UK2Node_SiriusFormatBase::FScopedExpansionStats::FScopedExpansionStats(const UEdGraph* InSourceGraph)
+	: SourceGraph(InSourceGraph),
+	  StartNumNodes(InSourceGraph->Nodes.Num()),
+	  StartTime(FPlatformTime::Seconds())
+{
+}
+
+UK2Node_SiriusFormatBase::FScopedExpansionStats::~FScopedExpansionStats()
+{
+	FSiriusExpansionStats& Stats = FSiriusExpansionStats::Get();
+	Stats.ExpandSeconds += FPlatformTime::Seconds() - StartTime;
+	Stats.NumExpandedNodes++;
+	Stats.NumIntermediateNodes += SourceGraph->Nodes.Num() - StartNumNodes;
+}
+
+UEdGraphPin* UK2Node_SiriusFormatBase::GetFormatPin() const
+{
+	if (!CachedFormatPin)
+	{
+		CachedFormatPin = FindPinChecked(GetFormatPinName(), EGPD_Input);
+	}
+	return CachedFormatPin;
+}
+
+UEdGraphPin* UK2Node_SiriusFormatBase::FindArgumentPin(const FName InPinName) const
+{
+	UpdateArgumentPinIndex();
+
+	UEdGraphPin* const* ArgumentPin = ArgumentPinIndex.Find(InPinName);
+	return ArgumentPin ? *ArgumentPin : nullptr;
+}
+
+void UK2Node_SiriusFormatBase::SynchronizeArgumentPinType(UEdGraphPin* Pin) const
+{
+	if (FindArgumentPin(Pin->PinName) == Pin)
+	{
+		bool bPinTypeChanged = false;
+		if (Pin->LinkedTo.Num() == 0)
+		{
+			static const FEdGraphPinType WildcardPinType = FEdGraphPinType(UEdGraphSchema_K2::PC_Wildcard, NAME_None, nullptr, EPinContainerType::None, false, FEdGraphTerminalType());
+
+			// Ensure wildcard
+			if (Pin->PinType != WildcardPinType)
+			{
+				Pin->PinType = WildcardPinType;
+				bPinTypeChanged = true;
+			}
+		}
+		else
+		{
+			const UEdGraphPin* ArgumentSourcePin = Pin->LinkedTo[0];
+
+			// Take the type of the connected pin
+			if (Pin->PinType != ArgumentSourcePin->PinType)
+			{
+				Pin->PinType = ArgumentSourcePin->PinType;
+				bPinTypeChanged = true;
+			}
+		}
+
+		if (bPinTypeChanged)
+		{
+			NotifyArgumentPinTypeChanged();
+		}
+	}
+}
+
+UK2Node_SiriusFormatBase::FScopedNotificationBatch::FScopedNotificationBatch(const UK2Node_SiriusFormatBase& InNode)
+	: Node(InNode),
+	  bBatching(CVarSiriusBatchPinNotifications.GetValueOnGameThread())
+{
+	if (bBatching)
+	{
+		++Node.NotificationBatchDepth;
+	}
+}
+
+UK2Node_SiriusFormatBase::FScopedNotificationBatch::~FScopedNotificationBatch()
+{
+	if (bBatching && --Node.NotificationBatchDepth == 0 && Node.bPendingTypeChangeNotification)
+	{
+		Node.bPendingTypeChangeNotification = false;
+		Node.NotifyArgumentPinTypeChanged();
+	}
+}
+
+void UK2Node_SiriusFormatBase::NotifyArgumentPinTypeChanged() const
+{
+	if (NotificationBatchDepth > 0)
+	{
+		bPendingTypeChangeNotification = true;
+		return;
+	}
+
+	// Let the graph know to refresh
+	GetGraph()->NotifyGraphChanged();
+
+	// While compiling or regenerating on load the Blueprint is rebuilt anyway, marking it as modified would only cause extra work.
+	UBlueprint* Blueprint = GetBlueprint();
+	if (!Blueprint->bBeingCompiled && !Blueprint->bIsRegeneratingOnLoad)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		Blueprint->BroadcastChanged();
+	}
+}
+
+UEdGraphPin* UK2Node_SiriusFormatBase::CreateArgumentPin(const FName InPinName)
+{
+	UpdateArgumentPinIndex();
+
+	return CreateIndexedArgumentPin(InPinName);
+}
+
+void UK2Node_SiriusFormatBase::InvalidateArgumentPinIndex()
+{
+	CachedFormatPin = nullptr;
+	bArgumentPinIndexDirty = true;
+}
+
+UEdGraphPin* UK2Node_SiriusFormatBase::CreateIndexedArgumentPin(const FName InPinName)
+{
+	// Insert the pin after the last argument pin, or after the format pin if there are none yet.
+	int32 InsertIndex = Pins.IndexOfByKey(GetFormatPin()) + 1;
+	for (int32 PinIdx = Pins.Num() - 1; PinIdx >= InsertIndex; --PinIdx)
+	{
+		if (ArgumentPinIndex.FindRef(Pins[PinIdx]->PinName) == Pins[PinIdx])
+		{
+			InsertIndex = PinIdx + 1;
+			break;
+		}
+	}
+
+	FCreatePinParams CreatePinParams;
+	CreatePinParams.Index = InsertIndex;
+	UEdGraphPin* NewPin = CreatePin(GetArgumentPinDirection(), UEdGraphSchema_K2::PC_Wildcard, InPinName, CreatePinParams);
+
+	ArgumentPinIndex.Add(InPinName, NewPin);
+	return NewPin;
+}
+
+void UK2Node_SiriusFormatBase::UpdateArgumentPinIndex() const
+{
+	// The pin count check catches pins that were (re)created by the engine, e.g. during reconstruction.
+	if (!bArgumentPinIndexDirty && ArgumentPinIndex.Num() == PinNames.Num())
+	{
+		return;
+	}
+
+	bArgumentPinIndexDirty = false;
+	ArgumentPinIndex.Reset();
+
+	SiriusK2NodeUtils::FNameSet ArgumentNames;
+	ArgumentNames.Append(PinNames);
+
+	const UEdGraphPin* FormatPin = FindPin(GetFormatPinName(), EGPD_Input);
+	const EEdGraphPinDirection ArgumentPinDirection = GetArgumentPinDirection();
+	for (UEdGraphPin* Pin : Pins)
+	{
+		if (Pin != FormatPin && Pin->Direction == ArgumentPinDirection && !Pin->ParentPin && ArgumentNames.Contains(Pin->PinName))
+		{
+			ArgumentPinIndex.Add(Pin->PinName, Pin);
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,61 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "K2Node_SiriusFormatName.h"
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "KismetCompiler.h"
+#include "SiriusPatternTable.h"
+#include "SiriusStringLibrary.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_SiriusFormatName"
+
+UK2Node_SiriusFormatName::UK2Node_SiriusFormatName(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeTooltip = LOCTEXT("NodeTooltip", "Builds a formatted name using available format argument values.\n  \u2022 Use {} to denote format arguments.\n  \u2022 Choices like {Count|plural(one=item,other=items)} only format the chosen text, but every argument pin is still evaluated and converted.\n  \u2022 Names are remembered per node, repeated argument values return the same name without formatting again.\n  \u2022 Argument types may be Byte, Enum, Integer, Integer64, Float, Double, Text, String, Name, Boolean, Object, Struct or an array of those.");
+}
+
+FText UK2Node_SiriusFormatName::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("NodeTitle", "Format Name (Sirius)");
+}
+
+void UK2Node_SiriusFormatName::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	const FScopedExpansionStats ExpansionStats(SourceGraph);
+
+	// Skip the Format String expansion, this node is replaced by its own call.
+	UK2Node_SiriusFormatBase::ExpandNode(CompilerContext, SourceGraph);
+
+	UK2Node_CallFunction* CallFormatFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CallFormatFunction->SetFromFunction(USiriusStringLibrary::StaticClass()->FindFunctionByName(GET_MEMBER_NAME_CHECKED(USiriusStringLibrary, FormatName)));
+	CallFormatFunction->AllocateDefaultPins();
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFormatFunction, this);
+
+	// Every node has its own names, pure nodes evaluated by multiple consumers share them anyway.
+	CompilerContext.GetSchema()->TrySetDefaultValue(*CallFormatFunction->FindPinChecked(TEXT("CallSite")), GetCallSiteName(CompilerContext));
+
+	if (GetFormatPin()->LinkedTo.Num() == 0)
+	{
+		const int64 PatternId = FSiriusPatternTable::GetPatternId(GetFormatPin()->DefaultValue);
+		CompilerContext.GetSchema()->TrySetDefaultValue(*CallFormatFunction->FindPinChecked(TEXT("PatternId")), LexToString(PatternId));
+	}
+
+	if (!ExpandArgumentPins(CompilerContext, SourceGraph, CallFormatFunction->FindPinChecked(TEXT("InArgs"))))
+	{
+		return;
+	}
+
+	CompilerContext.MovePinLinksToIntermediate(*GetResultPin(), *CallFormatFunction->GetReturnValuePin());
+	CompilerContext.MovePinLinksToIntermediate(*GetFormatPin(), *CallFormatFunction->FindPinChecked(TEXT("InPattern")));
+
+	BreakAllNodeLinks();
+}
+
+FName UK2Node_SiriusFormatName::GetResultPinCategory() const
+{
+	return UEdGraphSchema_K2::PC_Name;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,94 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "K2Node_SiriusFormatStringAsync.h"
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "KismetCompiler.h"
+#include "SiriusPatternTable.h"
+#include "SiriusStringLibrary.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_SiriusFormatStringAsync"
+
+const FName UK2Node_SiriusFormatStringAsync::CompletedPinName = TEXT("Completed");
+
+UK2Node_SiriusFormatStringAsync::UK2Node_SiriusFormatStringAsync(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeTooltip = LOCTEXT("NodeTooltip", "Builds a formatted string on a background task, for large strings like reports.\n  \u2022 Use {} to denote format arguments.\n  \u2022 Choices like {Count|plural(one=item,other=items)} only format the chosen text, but every argument pin is still evaluated and converted.\n  \u2022 Completed fires once the Result is available, or not at all if this object is destroyed first.\n  \u2022 Executing the node again while it is formatting starts over with the new argument values.\n  \u2022 Struct and array arguments are converted to text on the game thread before formatting starts.\n  \u2022 Argument types may be Byte, Enum, Integer, Integer64, Float, Double, Text, String, Name, Boolean, Object, Struct or an array of those.");
+}
+
+void UK2Node_SiriusFormatStringAsync::AllocateDefaultPins()
+{
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute);
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, CompletedPinName);
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_SiriusFormatStringAsync::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("NodeTitle", "Format String Async (Sirius)");
+}
+
+FText UK2Node_SiriusFormatStringAsync::GetPinDisplayName(const UEdGraphPin* Pin) const
+{
+	// Don't show the name of the input execution pin.
+	if (Pin->PinName == UEdGraphSchema_K2::PN_Execute)
+	{
+		return FText::GetEmpty();
+	}
+
+	return Super::GetPinDisplayName(Pin);
+}
+
+bool UK2Node_SiriusFormatStringAsync::IsCompatibleWithGraph(const UEdGraph* TargetGraph) const
+{
+	// Latent actions can only resume in event graphs and the macros placed in them.
+	const EGraphType GraphType = TargetGraph->GetSchema()->GetGraphType(TargetGraph);
+	return (GraphType == GT_Ubergraph || GraphType == GT_Macro) && Super::IsCompatibleWithGraph(TargetGraph);
+}
+
+FName UK2Node_SiriusFormatStringAsync::GetCornerIcon() const
+{
+	return TEXT("Graph.Latent.LatentIcon");
+}
+
+void UK2Node_SiriusFormatStringAsync::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	const FScopedExpansionStats ExpansionStats(SourceGraph);
+
+	// Skip the Format String expansion, this node is replaced by a latent call.
+	UK2Node_SiriusFormatBase::ExpandNode(CompilerContext, SourceGraph);
+
+	UK2Node_CallFunction* CallFormatFunction = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	CallFormatFunction->SetFromFunction(USiriusStringLibrary::StaticClass()->FindFunctionByName(GET_MEMBER_NAME_CHECKED(USiriusStringLibrary, FormatAsync)));
+	CallFormatFunction->AllocateDefaultPins();
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(CallFormatFunction, this);
+
+	if (GetFormatPin()->LinkedTo.Num() == 0)
+	{
+		const int64 PatternId = FSiriusPatternTable::GetPatternId(GetFormatPin()->DefaultValue);
+		CompilerContext.GetSchema()->TrySetDefaultValue(*CallFormatFunction->FindPinChecked(TEXT("PatternId")), LexToString(PatternId));
+	}
+
+	if (!ExpandArgumentPins(CompilerContext, SourceGraph, CallFormatFunction->FindPinChecked(TEXT("InArgs"))))
+	{
+		return;
+	}
+
+	// The latent call's Then pin fires once the task completed, its output holds the result from then on.
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *CallFormatFunction->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetCompletedPin(), *CallFormatFunction->GetThenPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetResultPin(), *CallFormatFunction->FindPinChecked(TEXT("OutResult")));
+	CompilerContext.MovePinLinksToIntermediate(*GetFormatPin(), *CallFormatFunction->FindPinChecked(TEXT("InPattern")));
+
+	BreakAllNodeLinks();
+}
+
+UEdGraphPin* UK2Node_SiriusFormatStringAsync::GetCompletedPin() const
+{
+	return FindPinChecked(CompletedPinName, EGPD_Output);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -2,14 +2,11 @@
 
 #include "K2Node_SiriusPrintStringFormatted.h"
 
-#include "BlueprintActionDatabaseRegistrar.h"
-#include "BlueprintNodeSpawner.h"
-#include "EditorCategoryUtils.h"
+#include "EdGraphSchema_K2.h"
 #include "K2Node_CallFunction.h"
-#include "K2Node_SiriusFormatString.h"
 #include "KismetCompiler.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Kismet2/BlueprintEditorUtils.h"
+#include "SiriusPatternTable.h"
+#include "SiriusStringLibrary.h"
 
 #define LOCTEXT_NAMESPACE "K2Node_SiriusPrintStringFormatted"
 
@@ -50,7 +47,7 @@ void UK2Node_SiriusPrintStringFormatted::AllocateDefaultPins()
 	DefaultSchema->SetPinAutogeneratedDefaultValue(FormatPin, TEXT("Hello"));
 	for (const FName& PinName : PinNames)
 	{
-		CachedArgumentPins.Emplace(CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, PinName));
+		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, PinName);
 	}
 
 	UEdGraphPin* PrintScreenPin = CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Boolean, PrintScreenPinName);
@@ -88,11 +85,6 @@ FText UK2Node_SiriusPrintStringFormatted::GetPinDisplayName(const UEdGraphPin* P
 	return FText::GetEmpty();
 }
 
-FText UK2Node_SiriusPrintStringFormatted::GetTooltipText() const
-{
-	return NodeTooltip;
-}
-
 void UK2Node_SiriusPrintStringFormatted::PinConnectionListChanged(UEdGraphPin* Pin)
 {
 	Modify();
@@ -101,94 +93,35 @@ void UK2Node_SiriusPrintStringFormatted::PinConnectionListChanged(UEdGraphPin* P
 	SynchronizeArgumentPinType(Pin);
 }
 
-void UK2Node_SiriusPrintStringFormatted::PinDefaultValueChanged(UEdGraphPin* Pin)
-{
-	// Detect if the format pin has changed.
-	const UEdGraphPin* FormatPin = GetFormatPin();
-	if (Pin == FormatPin && FormatPin->LinkedTo.Num() == 0)
-	{
-		TArray<FString> ArgumentParams;
-		FTextFormat::FromString(FormatPin->DefaultValue).GetFormatArgumentNames(ArgumentParams);
-
-		PinNames.Reset();
-
-		// Create argument pins if new arguments were created.
-		for (const FString& Param : ArgumentParams)
-		{
-			const FName ParamName(*Param);
-			if (!FindArgumentPin(ParamName))
-			{
-				// Insert the newly created argument pin(s) after the format pin and before the advanced option pins.
-				FCreatePinParams CreatePinParams;
-				CreatePinParams.Index = Pins.IndexOfByKey(FormatPin) + 1 + CachedArgumentPins.Num();
-				CachedArgumentPins.Emplace(CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, ParamName, CreatePinParams));
-			}
-			PinNames.Add(ParamName);
-		}
-
-		// Destroy argument pins whose arguments were destroyed.
-		for (auto It = Pins.CreateIterator(); It; ++It)
-		{
-			UEdGraphPin* CheckPin = *It;
-			if (FindArgumentPin(CheckPin->PinName))
-			{
-				const bool bIsValidArgPin = ArgumentParams.ContainsByPredicate([&CheckPin](const FString& InPinName)
-				{
-					return InPinName.Equals(CheckPin->PinName.ToString(), ESearchCase::CaseSensitive);
-				});
-
-				if (!bIsValidArgPin)
-				{
-					CheckPin->MarkAsGarbage();
-					It.RemoveCurrent();
-					CachedArgumentPins.Remove(CheckPin);
-				}
-			}
-		}
-
-		// Notify graph that something changed.
-		GetGraph()->NotifyGraphChanged();
-	}
-}
-
-void UK2Node_SiriusPrintStringFormatted::PinTypeChanged(UEdGraphPin* Pin)
-{
-	// Potentially update an argument pin type
-	SynchronizeArgumentPinType(Pin);
-
-	Super::PinTypeChanged(Pin);
-}
-
 void UK2Node_SiriusPrintStringFormatted::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
 {
-	Super::ExpandNode(CompilerContext, SourceGraph);
-
-	// Create a "FormatString" node to do the heavy lifting regarding the format string.
-	UK2Node_SiriusFormatString* FormatStringNode = CompilerContext.SpawnIntermediateNode<UK2Node_SiriusFormatString>(this, SourceGraph);
-	FormatStringNode->AllocateDefaultPins();
-	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(FormatStringNode, this);
+	const FScopedExpansionStats ExpansionStats(SourceGraph);
 
-	// Move the format and argument pins to the format string node.
-	CompilerContext.MovePinLinksToIntermediate(*GetFormatPin(), *FormatStringNode->GetFormatPin());
-	for (int32 ArgIdx = 0; ArgIdx < PinNames.Num(); ++ArgIdx)
-	{
-		const FName& PinName = PinNames[ArgIdx];
-		UEdGraphPin* ArgumentPin = FindArgumentPin(PinName);
-		UEdGraphPin* TargetPin = FormatStringNode->AddArgumentPin(PinName);
-		CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *TargetPin);
-		FormatStringNode->SynchronizeArgumentPinType(TargetPin);
-	}
+	Super::ExpandNode(CompilerContext, SourceGraph);
 
-	// Create a "PrintString" function node.
+	// Format and print in a single call, so the formatted string never has to pass through the Blueprint VM.
 	UK2Node_CallFunction* PrintStringNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	const UFunction* Function = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+	const UFunction* Function = USiriusStringLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, PrintStringFormatted));
 	PrintStringNode->SetFromFunction(Function);
 	PrintStringNode->AllocateDefaultPins();
 	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(PrintStringNode, this);
-	
+
+	if (!ExpandArgumentPins(CompilerContext, SourceGraph, PrintStringNode->FindPinChecked(TEXT("InArgs"))))
+	{
+		return;
+	}
+
+	// Literal patterns are known now, so they can be referenced by ID and don't have to be parsed at runtime.
+	UEdGraphPin* FormatPin = GetFormatPin();
+	if (FormatPin->LinkedTo.Num() == 0)
+	{
+		const int64 PatternId = FSiriusPatternTable::GetPatternId(FormatPin->DefaultValue);
+		CompilerContext.GetSchema()->TrySetDefaultValue(*PrintStringNode->FindPinChecked(TEXT("PatternId")), LexToString(PatternId));
+	}
+
 	// Link pins with print string function node.
 	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *PrintStringNode->GetExecPin());
-	FormatStringNode->GetResultPin()->MakeLinkTo(PrintStringNode->FindPinChecked(TEXT("InString")));
+	CompilerContext.MovePinLinksToIntermediate(*FormatPin, *PrintStringNode->FindPinChecked(TEXT("InPattern")));
 	CompilerContext.MovePinLinksToIntermediate(*GetPrintScreenPin(), *PrintStringNode->FindPinChecked(TEXT("bPrintToScreen")));
 	CompilerContext.MovePinLinksToIntermediate(*GetPrintLogPin(), *PrintStringNode->FindPinChecked(TEXT("bPrintToLog")));
 	CompilerContext.MovePinLinksToIntermediate(*GetTextColorPin(), *PrintStringNode->FindPinChecked(TEXT("TextColor")));
@@ -199,71 +132,6 @@ void UK2Node_SiriusPrintStringFormatted::ExpandNode(FKismetCompilerContext& Comp
 	BreakAllNodeLinks();
 }
 
-void UK2Node_SiriusPrintStringFormatted::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
-{
-	const UClass* ActionKey = GetClass();
-	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
-	{
-		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
-		check(NodeSpawner != nullptr);
-		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
-	}
-}
-
-FText UK2Node_SiriusPrintStringFormatted::GetMenuCategory() const
-{
-	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::String);
-}
-
-bool UK2Node_SiriusPrintStringFormatted::IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
-{
-	if (FindArgumentPin(MyPin->PinName))
-	{
-		const FName& OtherPinCategory = OtherPin->PinType.PinCategory;
-
-		bool bIsValidType = false;
-		if (OtherPinCategory == UEdGraphSchema_K2::PC_Int ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_Int64 ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_Real ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_Text ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_Byte ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_Boolean ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_String ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_Name ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_Object ||
-			OtherPinCategory == UEdGraphSchema_K2::PC_Wildcard)
-		{
-			bIsValidType = true;
-		}
-
-		if (!bIsValidType)
-		{
-			OutReason = LOCTEXT("Error_InvalidArgumentType", "Format arguments may only be Byte, Enum, Integer, Float, Text, String, Name, Boolean, Object or Wildcard.").ToString();
-			return true;
-		}
-	}
-
-	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
-}
-
-void UK2Node_SiriusPrintStringFormatted::PostReconstructNode()
-{
-	Super::PostReconstructNode();
-
-	if (!IsTemplate())
-	{
-		// Make sure we're not dealing with a menu node
-		if (GetSchema())
-		{
-			for (UEdGraphPin* CurrentPin : Pins)
-			{
-				// Potentially update an argument pin type
-				SynchronizeArgumentPinType(CurrentPin);
-			}
-		}
-	}
-}
-
 UEdGraphPin* UK2Node_SiriusPrintStringFormatted::GetExecutePin() const
 {
 	return FindPinChecked(ExecutePinName, EGPD_Input);
@@ -274,11 +142,6 @@ UEdGraphPin* UK2Node_SiriusPrintStringFormatted::GetThenPin() const
 	return FindPinChecked(ThenPinName, EGPD_Output);
 }
 
-UEdGraphPin* UK2Node_SiriusPrintStringFormatted::GetFormatPin() const
-{
-	return FindPinChecked(FormatPinName, EGPD_Input);
-}
-
 UEdGraphPin* UK2Node_SiriusPrintStringFormatted::GetPrintScreenPin() const
 {
 	return FindPinChecked(PrintScreenPinName, EGPD_Input);
@@ -299,71 +162,4 @@ UEdGraphPin* UK2Node_SiriusPrintStringFormatted::GetDurationPin() const
 	return FindPinChecked(DurationPinName, EGPD_Input);
 }
 
-UEdGraphPin* UK2Node_SiriusPrintStringFormatted::FindArgumentPin(const FName PinName) const
-{
-	// Check if cache is out-of-date.
-	if (CachedArgumentPins.Num() != PinNames.Num())
-	{
-		const_cast<UK2Node_SiriusPrintStringFormatted*>(this)->CachedArgumentPins.Reset();
-
-		const TArray<UEdGraphPin*> IgnorePins = {GetExecutePin(), GetThenPin(), GetFormatPin(), GetPrintScreenPin(), GetPrintLogPin(), GetTextColorPin(), GetDurationPin()};
-		for (UEdGraphPin* const Pin : Pins)
-		{
-			if (!IgnorePins.Contains(Pin))
-			{
-				const_cast<UK2Node_SiriusPrintStringFormatted*>(this)->CachedArgumentPins.Emplace(Pin);
-			}
-		}
-	}
-
-	UEdGraphPin* const* Find = CachedArgumentPins.FindByPredicate([&](const UEdGraphPin* const ArgumentPin)
-	{
-		return ArgumentPin->PinName.ToString().Equals(PinName.ToString(), ESearchCase::CaseSensitive);
-	});
-	return Find ? *Find : nullptr;
-}
-
-void UK2Node_SiriusPrintStringFormatted::SynchronizeArgumentPinType(UEdGraphPin* Pin) const
-{
-	if (FindArgumentPin(Pin->PinName))
-	{
-		bool bPinTypeChanged = false;
-		if (Pin->LinkedTo.Num() == 0)
-		{
-			static const FEdGraphPinType WildcardPinType = FEdGraphPinType(UEdGraphSchema_K2::PC_Wildcard, NAME_None, nullptr, EPinContainerType::None, false, FEdGraphTerminalType());
-
-			// Ensure wildcard
-			if (Pin->PinType != WildcardPinType)
-			{
-				Pin->PinType = WildcardPinType;
-				bPinTypeChanged = true;
-			}
-		}
-		else
-		{
-			const UEdGraphPin* ArgumentSourcePin = Pin->LinkedTo[0];
-
-			// Take the type of the connected pin
-			if (Pin->PinType != ArgumentSourcePin->PinType)
-			{
-				Pin->PinType = ArgumentSourcePin->PinType;
-				bPinTypeChanged = true;
-			}
-		}
-
-		if (bPinTypeChanged)
-		{
-			// Let the graph know to refresh
-			GetGraph()->NotifyGraphChanged();
-
-			UBlueprint* Blueprint = GetBlueprint();
-			if (!Blueprint->bBeingCompiled)
-			{
-				FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
-				Blueprint->BroadcastChanged();
-			}
-		}
-	}
-}
-
 #undef LOCTEXT_NAMESPACE
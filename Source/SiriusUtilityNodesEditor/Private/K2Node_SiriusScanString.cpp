@@ -0,0 +1,233 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "K2Node_SiriusScanString.h"
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "KismetCompiler.h"
+#include "SiriusPatternTable.h"
+#include "SiriusStringFormatPattern.h"
+#include "SiriusStringLibrary.h"
+#include "SiriusStringScanner.h"
+
+#define LOCTEXT_NAMESPACE "K2Node_SiriusScanString"
+
+const FName UK2Node_SiriusScanString::ExecutePinName = UEdGraphSchema_K2::PN_Execute;
+const FName UK2Node_SiriusScanString::ThenPinName = UEdGraphSchema_K2::PN_Then;
+const FName UK2Node_SiriusScanString::SourcePinName = TEXT("Source");
+const FName UK2Node_SiriusScanString::PatternPinName = TEXT("Pattern");
+const FName UK2Node_SiriusScanString::SuccessPinName = TEXT("Success");
+
+UK2Node_SiriusScanString::UK2Node_SiriusScanString()
+{
+	NodeTooltip = LOCTEXT("NodeTooltip", "Matches a string against a pattern and outputs the values of its arguments.\n  \u2022 Use {} to denote arguments, literal text must match exactly.\n  \u2022 Argument types may be Integer, Integer64, Float, Double, Boolean, String, Name or Text.\n  \u2022 Success is false if the string doesn't match or a number could not be converted.");
+}
+
+void UK2Node_SiriusScanString::AllocateDefaultPins()
+{
+	Super::AllocateDefaultPins();
+
+	// Execution pins
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, ExecutePinName);
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, ThenPinName);
+
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_String, SourcePinName);
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_String, PatternPinName);
+	CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Boolean, SuccessPinName);
+
+	for (const FName& PinName : PinNames)
+	{
+		CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, PinName);
+	}
+}
+
+FText UK2Node_SiriusScanString::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("NodeTitle", "Scan String (Sirius)");
+}
+
+FText UK2Node_SiriusScanString::GetPinDisplayName(const UEdGraphPin* Pin) const
+{
+	// Don't show the names of the execution pins.
+	if (Pin != GetExecutePin() && Pin != GetThenPin())
+	{
+		return FText::FromName(Pin->PinName);
+	}
+
+	return FText::GetEmpty();
+}
+
+void UK2Node_SiriusScanString::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Modify();
+
+	// Potentially update an argument pin type
+	SynchronizeArgumentPinType(Pin);
+}
+
+bool UK2Node_SiriusScanString::IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (FindArgumentPin(MyPin->PinName) == MyPin)
+	{
+		const FName& OtherPinCategory = OtherPin->PinType.PinCategory;
+
+		// Only types that can be converted from text
+		const bool bIsValidType = !OtherPin->PinType.IsContainer() && (
+			OtherPinCategory == UEdGraphSchema_K2::PC_Int ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Int64 ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Real ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Boolean ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_String ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Name ||
+			OtherPinCategory == UEdGraphSchema_K2::PC_Text);
+
+		if (!bIsValidType)
+		{
+			OutReason = LOCTEXT("Error_InvalidArgumentType", "Scanned arguments may only be Integer, Integer64, Float, Double, Boolean, String, Name or Text.").ToString();
+			return true;
+		}
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_SiriusScanString::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+{
+	const FScopedExpansionStats ExpansionStats(SourceGraph);
+
+	Super::ExpandNode(CompilerContext, SourceGraph);
+
+	const UEdGraphSchema_K2* Schema = CompilerContext.GetSchema();
+
+	// Choices can't be inverted, a literal pattern with them would never match at runtime.
+	UEdGraphPin* PatternPin = GetFormatPin();
+	if (PatternPin->LinkedTo.Num() == 0)
+	{
+		TArray<FSiriusStringFormatSegment> Segments;
+		FSiriusStringFormatPattern::Parse(PatternPin->DefaultValue, Segments);
+		if (Segments.ContainsByPredicate([](const FSiriusStringFormatSegment& Segment) { return Segment.NumChildren > 0; }))
+		{
+			CompilerContext.MessageLog.Error(*LOCTEXT("Error_PatternHasChoices", "@@ can't match a pattern with plural, select or if choices, scan their argument instead").ToString(), this);
+			return;
+		}
+	}
+
+	// Match and convert all arguments in a single call.
+	UK2Node_CallFunction* ScanNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+	ScanNode->SetFromFunction(USiriusStringLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, Scan)));
+	ScanNode->AllocateDefaultPins();
+	CompilerContext.MessageLog.NotifyIntermediateObjectCreation(ScanNode, this);
+
+	// Literal patterns are known now, so they can be referenced by ID and don't have to be parsed at runtime.
+	if (PatternPin->LinkedTo.Num() == 0)
+	{
+		const int64 PatternId = FSiriusPatternTable::GetPatternId(PatternPin->DefaultValue);
+		Schema->TrySetDefaultValue(*ScanNode->FindPinChecked(TEXT("PatternId")), LexToString(PatternId));
+	}
+
+	// The values of the arguments are in order of appearance in the pattern, which is the order of the pins.
+	UEdGraphPin* ValuesPin = ScanNode->FindPinChecked(TEXT("OutValues"));
+	FString TypeCodes;
+	for (int32 ArgIdx = 0; ArgIdx < PinNames.Num(); ++ArgIdx)
+	{
+		UEdGraphPin* ArgumentPin = FindArgumentPin(PinNames[ArgIdx]);
+		const FName& ArgumentPinCategory = ArgumentPin->PinType.PinCategory;
+
+		TCHAR TypeCode = FSiriusStringScanner::StringTypeCode;
+		FName GetterName;
+		if (ArgumentPin->LinkedTo.Num() == 0)
+		{
+			// Still matched, but the value isn't used.
+		}
+		else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Int)
+		{
+			TypeCode = FSiriusStringScanner::IntTypeCode;
+			GetterName = GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, GetScannedInt);
+		}
+		else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Int64)
+		{
+			TypeCode = FSiriusStringScanner::Int64TypeCode;
+			GetterName = GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, GetScannedInt64);
+		}
+		else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Real && ArgumentPin->PinType.PinSubCategory == UEdGraphSchema_K2::PC_Float)
+		{
+			TypeCode = FSiriusStringScanner::FloatTypeCode;
+			GetterName = GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, GetScannedFloat);
+		}
+		else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Real)
+		{
+			TypeCode = FSiriusStringScanner::DoubleTypeCode;
+			GetterName = GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, GetScannedDouble);
+		}
+		else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Boolean)
+		{
+			TypeCode = FSiriusStringScanner::BoolTypeCode;
+			GetterName = GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, GetScannedBool);
+		}
+		else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_String)
+		{
+			GetterName = GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, GetScannedString);
+		}
+		else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Name)
+		{
+			GetterName = GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, GetScannedName);
+		}
+		else if (ArgumentPinCategory == UEdGraphSchema_K2::PC_Text)
+		{
+			GetterName = GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, GetScannedText);
+		}
+		else
+		{
+			// Unexpected pin type!
+			CompilerContext.MessageLog.Error(*FText::Format(LOCTEXT("Error_UnexpectedPinType", "Pin '{0}' has an unexpected type: {1}"), FText::FromName(PinNames[ArgIdx]), FText::FromName(ArgumentPinCategory)).ToString());
+			return;
+		}
+		TypeCodes.AppendChar(TypeCode);
+
+		if (!GetterName.IsNone())
+		{
+			// Reads the converted value from the result of the scan.
+			UK2Node_CallFunction* GetterNode = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
+			GetterNode->SetFromFunction(USiriusStringLibrary::StaticClass()->FindFunctionByName(GetterName));
+			GetterNode->AllocateDefaultPins();
+			CompilerContext.MessageLog.NotifyIntermediateObjectCreation(GetterNode, this);
+
+			ValuesPin->MakeLinkTo(GetterNode->FindPinChecked(TEXT("Values")));
+			Schema->TrySetDefaultValue(*GetterNode->FindPinChecked(TEXT("Index")), FString::FromInt(ArgIdx));
+			CompilerContext.MovePinLinksToIntermediate(*ArgumentPin, *GetterNode->GetReturnValuePin());
+		}
+	}
+	Schema->TrySetDefaultValue(*ScanNode->FindPinChecked(TEXT("TypeCodes")), TypeCodes);
+
+	// Link pins with the scan function node.
+	CompilerContext.MovePinLinksToIntermediate(*GetExecPin(), *ScanNode->GetExecPin());
+	CompilerContext.MovePinLinksToIntermediate(*GetSourcePin(), *ScanNode->FindPinChecked(TEXT("Source")));
+	CompilerContext.MovePinLinksToIntermediate(*PatternPin, *ScanNode->FindPinChecked(TEXT("InPattern")));
+	CompilerContext.MovePinLinksToIntermediate(*GetSuccessPin(), *ScanNode->GetReturnValuePin());
+	CompilerContext.MovePinLinksToIntermediate(*GetThenPin(), *ScanNode->GetThenPin());
+
+	// Final step, break all links to this node as we've finished expanding it.
+	BreakAllNodeLinks();
+}
+
+UEdGraphPin* UK2Node_SiriusScanString::GetExecutePin() const
+{
+	return FindPinChecked(ExecutePinName, EGPD_Input);
+}
+
+UEdGraphPin* UK2Node_SiriusScanString::GetThenPin() const
+{
+	return FindPinChecked(ThenPinName, EGPD_Output);
+}
+
+UEdGraphPin* UK2Node_SiriusScanString::GetSourcePin() const
+{
+	return FindPinChecked(SourcePinName, EGPD_Input);
+}
+
+UEdGraphPin* UK2Node_SiriusScanString::GetSuccessPin() const
+{
+	return FindPinChecked(SuccessPinName, EGPD_Output);
+}
+
+#undef LOCTEXT_NAMESPACE
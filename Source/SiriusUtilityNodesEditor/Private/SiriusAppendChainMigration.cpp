@@ -0,0 +1,304 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusAppendChainMigration.h"
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_SiriusFormatString.h"
+#include "K2Node_VariableGet.h"
+#include "SiriusK2NodeUtils.h"
+#include "Algo/Find.h"
+#include "Engine/Blueprint.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Kismet/KismetTextLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+
+namespace SiriusAppendChainMigration
+{
+	/** Returns the function called by the node if it is a member of the given class */
+	static const UFunction* GetLibraryFunction(const UEdGraphNode* Node, const UClass* LibraryClass)
+	{
+		const UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node);
+		const UFunction* Function = CallFunctionNode ? CallFunctionNode->GetTargetFunction() : nullptr;
+		return Function && Function->GetOwnerClass() == LibraryClass ? Function : nullptr;
+	}
+
+	/** Returns the input pin of a conversion node whose result the Format String node produces for the same argument, or null */
+	static UEdGraphPin* GetExactConversionInputPin(UEdGraphNode* Node)
+	{
+		static const FName StringConversions[] = {
+			GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, Conv_IntToString),
+			GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, Conv_Int64ToString),
+			GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, Conv_ByteToString),
+			GET_FUNCTION_NAME_CHECKED_OneParam(UKismetStringLibrary, Conv_BoolToString, bool),
+			GET_FUNCTION_NAME_CHECKED_OneParam(UKismetStringLibrary, Conv_NameToString, FName),
+			GET_FUNCTION_NAME_CHECKED_OneParam(UKismetStringLibrary, Conv_ObjectToString, UObject*),
+		};
+
+		bool bIsExactConversion = false;
+		if (const UFunction* Function = GetLibraryFunction(Node, UKismetStringLibrary::StaticClass()))
+		{
+			bIsExactConversion = Algo::Find(StringConversions, Function->GetFName()) != nullptr;
+		}
+		else if (const UFunction* TextFunction = GetLibraryFunction(Node, UKismetTextLibrary::StaticClass()))
+		{
+			bIsExactConversion = TextFunction->GetFName() == GET_FUNCTION_NAME_CHECKED_OneParam(UKismetTextLibrary, Conv_TextToString, FText);
+		}
+
+		if (!bIsExactConversion)
+		{
+			return nullptr;
+		}
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction == EGPD_Input && !Pin->bHidden && Pin->LinkedTo.Num() == 1)
+			{
+				// Enums are formatted by their display name, while their conversion to string returns the number.
+				const UEdGraphPin* SourcePin = Pin->LinkedTo[0];
+				if (SourcePin->PinType.PinCategory == UEdGraphSchema_K2::PC_Byte && SourcePin->PinType.PinSubCategoryObject.IsValid())
+				{
+					return nullptr;
+				}
+				return Pin;
+			}
+		}
+		return nullptr;
+	}
+
+	/** Returns the pin providing the value of a node's output pin if the output is only used by one other pin */
+	static UEdGraphPin* GetSoleLinkedPin(const UEdGraphPin* Pin)
+	{
+		return Pin->LinkedTo.Num() == 1 ? Pin->LinkedTo[0] : nullptr;
+	}
+
+	/** Builds the pattern and arguments of a chain */
+	class FChainBuilder
+	{
+	public:
+		explicit FChainBuilder(FChain& InChain)
+			: Chain(InChain)
+		{
+		}
+
+		void AddAppendNode(UK2Node_CallFunction* AppendNode)
+		{
+			Chain.Nodes.Add(AppendNode);
+
+			for (UEdGraphPin* Pin : AppendNode->Pins)
+			{
+				if (Pin->Direction != EGPD_Input || Pin->bHidden || Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_String)
+				{
+					continue;
+				}
+
+				if (Pin->LinkedTo.Num() == 0)
+				{
+					AddLiteral(Pin->DefaultValue);
+					continue;
+				}
+
+				UEdGraphPin* SourcePin = Pin->LinkedTo[0];
+				UEdGraphNode* SourceNode = SourcePin->GetOwningNode();
+				const bool bOnlyUsedHere = SourcePin->LinkedTo.Num() == 1;
+
+				if (bOnlyUsedHere && IsAppendNode(SourceNode))
+				{
+					AddAppendNode(CastChecked<UK2Node_CallFunction>(SourceNode));
+				}
+				else if (UEdGraphPin* ConversionInputPin = bOnlyUsedHere ? GetExactConversionInputPin(SourceNode) : nullptr)
+				{
+					Chain.Nodes.Add(SourceNode);
+					AddArgument(ConversionInputPin->LinkedTo[0]);
+				}
+				else
+				{
+					AddArgument(SourcePin);
+				}
+			}
+		}
+
+	private:
+		void AddLiteral(const FString& Literal)
+		{
+			for (const TCHAR Char : Literal)
+			{
+				if (Char == TEXT('{') || Char == TEXT('}') || Char == TEXT('`'))
+				{
+					Chain.Pattern.AppendChar(TEXT('`'));
+				}
+				Chain.Pattern.AppendChar(Char);
+			}
+		}
+
+		void AddArgument(UEdGraphPin* SourcePin)
+		{
+			// The same value used twice is the same argument.
+			FName& ArgumentName = ArgumentNames.FindOrAdd(SourcePin);
+			if (ArgumentName.IsNone())
+			{
+				ArgumentName = MakeUniqueArgumentName(SourcePin);
+				Chain.Arguments.Emplace(ArgumentName, SourcePin);
+			}
+
+			Chain.Pattern += FString::Printf(TEXT("{%s}"), *ArgumentName.ToString());
+		}
+
+		/** Names arguments after the variable they read, or numbers them */
+		FName MakeUniqueArgumentName(const UEdGraphPin* SourcePin)
+		{
+			FString BaseName;
+			if (const UK2Node_VariableGet* VariableNode = Cast<UK2Node_VariableGet>(SourcePin->GetOwningNode()))
+			{
+				for (const TCHAR Char : VariableNode->GetVarNameString())
+				{
+					if (FChar::IsAlnum(Char) || Char == TEXT('_'))
+					{
+						BaseName.AppendChar(Char);
+					}
+				}
+			}
+			if (BaseName.IsEmpty())
+			{
+				BaseName = FString::Printf(TEXT("Arg%d"), Chain.Arguments.Num());
+			}
+
+			FName Name(*BaseName);
+			for (int32 Suffix = 1; UsedNames.Contains(Name); ++Suffix)
+			{
+				Name = FName(*FString::Printf(TEXT("%s_%d"), *BaseName, Suffix));
+			}
+			UsedNames.Add(Name);
+			return Name;
+		}
+
+		FChain& Chain;
+		TMap<const UEdGraphPin*, FName> ArgumentNames;
+		SiriusK2NodeUtils::FNameSet UsedNames;
+	};
+
+	bool IsAppendNode(const UEdGraphNode* Node)
+	{
+		const UFunction* Function = GetLibraryFunction(Node, UKismetStringLibrary::StaticClass());
+		return Function && Function->GetFName() == GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, Concat_StrStr);
+	}
+
+	UK2Node_CallFunction* FindChainRoot(UK2Node_CallFunction* AppendNode)
+	{
+		UK2Node_CallFunction* Root = AppendNode;
+		while (const UEdGraphPin* LinkedPin = GetSoleLinkedPin(Root->GetReturnValuePin()))
+		{
+			if (!IsAppendNode(LinkedPin->GetOwningNode()))
+			{
+				break;
+			}
+			Root = CastChecked<UK2Node_CallFunction>(LinkedPin->GetOwningNode());
+		}
+		return Root;
+	}
+
+	bool AnalyzeChain(UK2Node_CallFunction* Root, FChain& OutChain)
+	{
+		OutChain = FChain();
+		OutChain.Root = Root;
+
+		FChainBuilder Builder(OutChain);
+		Builder.AddAppendNode(Root);
+
+		// A single Append without conversions is already a single call.
+		return OutChain.Nodes.Num() > 1;
+	}
+
+	void FindChains(UBlueprint* Blueprint, TArray<FChain>& OutChains)
+	{
+		TArray<UEdGraph*> Graphs;
+		Blueprint->GetAllGraphs(Graphs);
+
+		for (const UEdGraph* Graph : Graphs)
+		{
+			for (UEdGraphNode* Node : Graph->Nodes)
+			{
+				// Start at the end of each chain, nodes absorbed by a chain are never a root.
+				if (IsAppendNode(Node) && FindChainRoot(CastChecked<UK2Node_CallFunction>(Node)) == Node)
+				{
+					FChain Chain;
+					if (AnalyzeChain(CastChecked<UK2Node_CallFunction>(Node), Chain))
+					{
+						OutChains.Add(MoveTemp(Chain));
+					}
+				}
+			}
+		}
+	}
+
+	FSiriusAppendChainMigrationStats GetStats(const TArray<FChain>& Chains)
+	{
+		FSiriusAppendChainMigrationStats Stats;
+		for (const FChain& Chain : Chains)
+		{
+			Stats.NumChains++;
+			Stats.NumNodesRemoved += Chain.Nodes.Num();
+			Stats.NumNodesAdded++;
+
+			// Every replaced node is a call producing a temporary string, the Format String node is a single call.
+			Stats.NumCallsSaved += Chain.Nodes.Num() - 1;
+		}
+		return Stats;
+	}
+
+	void ApplyChains(UBlueprint* Blueprint, const TArray<FChain>& Chains)
+	{
+		const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+		// A chain can use the result of another one, which is replaced by the Result pin of its Format String node.
+		TMap<const UEdGraphPin*, UEdGraphPin*> ReplacedPins;
+
+		for (const FChain& Chain : Chains)
+		{
+			UEdGraph* Graph = Chain.Root->GetGraph();
+			Graph->Modify();
+
+			FGraphNodeCreator<UK2Node_SiriusFormatString> NodeCreator(*Graph);
+			UK2Node_SiriusFormatString* FormatNode = NodeCreator.CreateNode(false);
+			FormatNode->NodePosX = Chain.Root->NodePosX;
+			FormatNode->NodePosY = Chain.Root->NodePosY;
+			NodeCreator.Finalize();
+
+			// Setting the pattern creates the argument pins.
+			Schema->TrySetDefaultValue(*FormatNode->GetFormatPin(), Chain.Pattern);
+
+			for (const TPair<FName, UEdGraphPin*>& Argument : Chain.Arguments)
+			{
+				UEdGraphPin* SourcePin = Argument.Value;
+				if (UEdGraphPin* const* ReplacedPin = ReplacedPins.Find(SourcePin))
+				{
+					SourcePin = *ReplacedPin;
+				}
+
+				if (UEdGraphPin* ArgumentPin = FormatNode->FindArgumentPin(Argument.Key))
+				{
+					Schema->TryCreateConnection(SourcePin, ArgumentPin);
+				}
+			}
+
+			UEdGraphPin* RootResultPin = Chain.Root->GetReturnValuePin();
+			UEdGraphPin* ResultPin = FormatNode->GetResultPin();
+			for (UEdGraphPin* TargetPin : TArray<UEdGraphPin*>(RootResultPin->LinkedTo))
+			{
+				RootResultPin->BreakLinkTo(TargetPin);
+				Schema->TryCreateConnection(ResultPin, TargetPin);
+			}
+			ReplacedPins.Add(RootResultPin, ResultPin);
+
+			for (UEdGraphNode* Node : Chain.Nodes)
+			{
+				FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+			}
+		}
+
+		if (Chains.Num() > 0)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		}
+	}
+}
@@ -0,0 +1,71 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraphNode;
+class UEdGraphPin;
+class UK2Node_CallFunction;
+
+/** Node counts of migrated Append chains, summed per Blueprint or project */
+struct FSiriusAppendChainMigrationStats
+{
+	int32 NumChains = 0;
+	int32 NumNodesRemoved = 0;
+	int32 NumNodesAdded = 0;
+
+	/** Estimated number of VM calls and temporary strings saved per execution of all migrated chains */
+	int32 NumCallsSaved = 0;
+
+	FSiriusAppendChainMigrationStats& operator+=(const FSiriusAppendChainMigrationStats& Other)
+	{
+		NumChains += Other.NumChains;
+		NumNodesRemoved += Other.NumNodesRemoved;
+		NumNodesAdded += Other.NumNodesAdded;
+		NumCallsSaved += Other.NumCallsSaved;
+		return *this;
+	}
+};
+
+/**
+ * Replaces chains of Append nodes, and the string conversions feeding them, by a single Format String node.
+ *
+ * Conversions are only folded into the pattern if the Format String node produces the exact same text for the argument,
+ * e.g. integers are, but floats are formatted differently and keep their conversion node.
+ */
+namespace SiriusAppendChainMigration
+{
+	/** A chain of Append nodes ending in Root and the Format String node replacing it */
+	struct FChain
+	{
+		UK2Node_CallFunction* Root = nullptr;
+
+		/** All nodes replaced by the Format String node, including the root */
+		TArray<UEdGraphNode*> Nodes;
+
+		FString Pattern;
+
+		/** Argument names and the pins providing their value, in order of appearance */
+		TArray<TPair<FName, UEdGraphPin*>> Arguments;
+	};
+
+	/** Returns true if the node is an Append node */
+	bool IsAppendNode(const UEdGraphNode* Node);
+
+	/** Returns the last Append node of the chain the given Append node is part of */
+	UK2Node_CallFunction* FindChainRoot(UK2Node_CallFunction* AppendNode);
+
+	/** Collects the chain ending in the given Append node, returns false if replacing it wouldn't save any node */
+	bool AnalyzeChain(UK2Node_CallFunction* Root, FChain& OutChain);
+
+	/** Finds all chains in the Blueprint worth replacing */
+	void FindChains(UBlueprint* Blueprint, TArray<FChain>& OutChains);
+
+	/** Returns the stats of replacing the given chains */
+	FSiriusAppendChainMigrationStats GetStats(const TArray<FChain>& Chains);
+
+	/** Replaces the chains by Format String nodes, they must have been found by FindChains on the same Blueprint */
+	void ApplyChains(UBlueprint* Blueprint, const TArray<FChain>& Chains);
+}
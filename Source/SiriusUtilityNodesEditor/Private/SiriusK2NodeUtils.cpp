@@ -0,0 +1,46 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusK2NodeUtils.h"
+
+#include "SiriusStringFormatPattern.h"
+
+void SiriusK2NodeUtils::GetPatternArgumentNames(const FString& Pattern, TArray<FName>& OutArgumentNames)
+{
+	// Use the same parser as the runtime, so pins always match the arguments that will be formatted.
+	TArray<FSiriusStringFormatSegment> Segments;
+	FSiriusStringFormatPattern::Parse(Pattern, Segments);
+
+	FNameSet AddedNames;
+	OutArgumentNames.Reset();
+	for (const FSiriusStringFormatSegment& Segment : Segments)
+	{
+		if (Segment.HasArgumentName())
+		{
+			const FName ArgumentName(Segment.NameLength, *Pattern + Segment.NameOffset);
+
+			bool bAlreadyAdded = false;
+			AddedNames.Add(ArgumentName, &bAlreadyAdded);
+			if (!bAlreadyAdded)
+			{
+				OutArgumentNames.Add(ArgumentName);
+			}
+		}
+	}
+}
+
+bool SiriusK2NodeUtils::AreNamesEqual(const TArray<FName>& A, const TArray<FName>& B)
+{
+	if (A.Num() != B.Num())
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < A.Num(); ++Index)
+	{
+		if (!A[Index].IsEqual(B[Index], ENameCase::CaseSensitive))
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,24 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace SiriusK2NodeUtils
+{
+	/** Set key funcs matching names case sensitively, the way argument pins are matched */
+	struct FCaseSensitiveNameKeyFuncs : BaseKeyFuncs<FName, FName, false>
+	{
+		static FORCEINLINE const FName& GetSetKey(const FName& Element) { return Element; }
+		static FORCEINLINE bool Matches(const FName& A, const FName& B) { return A.IsEqual(B, ENameCase::CaseSensitive); }
+		static FORCEINLINE uint32 GetKeyHash(const FName& Key) { return GetTypeHash(Key); }
+	};
+
+	using FNameSet = TSet<FName, FCaseSensitiveNameKeyFuncs>;
+
+	/** Returns the unique argument names of a pattern, in order of appearance */
+	void GetPatternArgumentNames(const FString& Pattern, TArray<FName>& OutArgumentNames);
+
+	/** Returns true if both lists contain the same names in the same order, compared case sensitively */
+	bool AreNamesEqual(const TArray<FName>& A, const TArray<FName>& B);
+}
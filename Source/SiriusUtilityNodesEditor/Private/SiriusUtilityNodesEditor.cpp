@@ -2,9 +2,18 @@
 
 #include "SiriusUtilityNodesEditor.h"
 
+#include "K2Node_CallFunction.h"
 #include "K2Node_SiriusFormatString.h"
 #include "PropertyEditorModule.h"
+#include "ScopedTransaction.h"
+#include "SiriusAppendChainMigration.h"
+#include "ToolMenus.h"
 #include "Details/FormatStringDetails.h"
+#include "EdGraph/EdGraphSchema.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "SiriusUtilityNodesEditor"
 
 IMPLEMENT_MODULE(FSiriusUtilityNodesEditorModule, SiriusUtilityNodesEditor)
 
@@ -13,10 +22,15 @@ void FSiriusUtilityNodesEditorModule::StartupModule()
 	// Register the details customizer
 	FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
 	PropertyModule.RegisterCustomClassLayout(UK2Node_SiriusFormatString::StaticClass()->GetFName(), FOnGetDetailCustomizationInstance::CreateStatic(&FFormatStringDetails::MakeInstance));
+
+	UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FSiriusUtilityNodesEditorModule::RegisterMenus));
 }
 
 void FSiriusUtilityNodesEditorModule::ShutdownModule()
 {
+	UToolMenus::UnRegisterStartupCallback(this);
+	UToolMenus::UnregisterOwner(this);
+
 	// Unregister the details customization
 	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
 	{
@@ -25,3 +39,58 @@ void FSiriusUtilityNodesEditorModule::ShutdownModule()
 		PropertyModule.NotifyCustomizationModuleChanged();
 	}
 }
+
+void FSiriusUtilityNodesEditorModule::RegisterMenus()
+{
+	FToolMenuOwnerScoped OwnerScoped(this);
+
+	UToolMenu* Menu = UToolMenus::Get()->ExtendMenu("GraphEditor.GraphNodeContextMenu.K2Node_CallFunction");
+	FToolMenuSection& Section = Menu->FindOrAddSection("SiriusUtilityNodes", LOCTEXT("SiriusSection", "Sirius"));
+	Section.AddDynamicEntry("ConvertAppendChain", FNewToolMenuSectionDelegate::CreateLambda([](FToolMenuSection& InSection)
+	{
+		const UGraphNodeContextMenuContext* Context = InSection.FindContext<UGraphNodeContextMenuContext>();
+		if (!Context || !Context->Blueprint || Context->bIsDebugging || !SiriusAppendChainMigration::IsAppendNode(Context->Node))
+		{
+			return;
+		}
+
+		TWeakObjectPtr<UBlueprint> WeakBlueprint = const_cast<UBlueprint*>(Context->Blueprint);
+		TWeakObjectPtr<UK2Node_CallFunction> WeakNode = const_cast<UK2Node_CallFunction*>(CastChecked<UK2Node_CallFunction>(Context->Node));
+
+		InSection.AddMenuEntry(
+			"ConvertAppendChain",
+			LOCTEXT("ConvertAppendChain", "Convert to Format String"),
+			LOCTEXT("ConvertAppendChainTooltip", "Replaces this chain of Append nodes, and the string conversions feeding it, by a single Format String node."),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateLambda([WeakBlueprint, WeakNode]()
+			{
+				UBlueprint* Blueprint = WeakBlueprint.Get();
+				UK2Node_CallFunction* Node = WeakNode.Get();
+				if (!Blueprint || !Node)
+				{
+					return;
+				}
+
+				TArray<SiriusAppendChainMigration::FChain> Chains;
+				if (!SiriusAppendChainMigration::AnalyzeChain(SiriusAppendChainMigration::FindChainRoot(Node), Chains.AddDefaulted_GetRef()))
+				{
+					FNotificationInfo Info(LOCTEXT("ConvertAppendChainNothingToDo", "This Append chain is already a single call."));
+					Info.ExpireDuration = 3.0f;
+					FSlateNotificationManager::Get().AddNotification(Info);
+					return;
+				}
+
+				const FSiriusAppendChainMigrationStats Stats = SiriusAppendChainMigration::GetStats(Chains);
+				{
+					const FScopedTransaction Transaction(LOCTEXT("ConvertAppendChainTransaction", "Convert to Format String"));
+					SiriusAppendChainMigration::ApplyChains(Blueprint, Chains);
+				}
+
+				FNotificationInfo Info(FText::Format(LOCTEXT("ConvertAppendChainDone", "Replaced {0} nodes by a Format String node, saving ~{1} calls per execution."), Stats.NumNodesRemoved, Stats.NumCallsSaved));
+				Info.ExpireDuration = 3.0f;
+				FSlateNotificationManager::Get().AddNotification(Info);
+			})));
+	}));
+}
+
+#undef LOCTEXT_NAMESPACE
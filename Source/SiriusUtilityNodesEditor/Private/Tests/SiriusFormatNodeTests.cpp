@@ -0,0 +1,252 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_SiriusFormatString.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SiriusFormatNodeTests
+{
+	/** Creates a transient Actor Blueprint to place nodes in */
+	UBlueprint* CreateBlueprint(const TCHAR* Name)
+	{
+		return FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), Name), BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	}
+
+	UK2Node_SiriusFormatString* CreateFormatStringNode(UEdGraph& Graph)
+	{
+		FGraphNodeCreator<UK2Node_SiriusFormatString> NodeCreator(Graph);
+		UK2Node_SiriusFormatString* Node = NodeCreator.CreateNode(false);
+		NodeCreator.Finalize();
+		return Node;
+	}
+
+	/** Returns a pattern with the given number of arguments, named Arg0 to ArgN */
+	FString MakePattern(const int32 NumArgs)
+	{
+		TStringBuilder<1024> Pattern;
+		for (int32 ArgIdx = 0; ArgIdx < NumArgs; ++ArgIdx)
+		{
+			Pattern.Appendf(TEXT("Value %d is {Arg%d}. "), ArgIdx, ArgIdx);
+		}
+		return FString(Pattern.ToView());
+	}
+
+	/** Creates a pure node whose float output can be linked to argument pins */
+	UEdGraphPin* CreateFloatSourcePin(UEdGraph& Graph)
+	{
+		FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(Graph);
+		UK2Node_CallFunction* Node = NodeCreator.CreateNode(false);
+		Node->SetFromFunction(UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, GetGameTimeInSeconds)));
+		NodeCreator.Finalize();
+		return Node->GetReturnValuePin();
+	}
+
+	/** Returns the number of pins in Pins that are not in OtherPins */
+	int32 CountPinsNotIn(const TArray<UEdGraphPin*>& Pins, const TArray<UEdGraphPin*>& OtherPins)
+	{
+		int32 NumPins = 0;
+		for (const UEdGraphPin* Pin : Pins)
+		{
+			NumPins += OtherPins.Contains(Pin) ? 0 : 1;
+		}
+		return NumPins;
+	}
+
+	/** Counts the graph change notifications while it is in scope */
+	struct FScopedGraphChangedCounter
+	{
+		explicit FScopedGraphChangedCounter(UEdGraph& InGraph)
+			: Graph(InGraph)
+		{
+			Handle = Graph.AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateLambda([this](const FEdGraphEditAction&)
+			{
+				++NumNotifications;
+			}));
+		}
+
+		~FScopedGraphChangedCounter()
+		{
+			Graph.RemoveOnGraphChangedHandler(Handle);
+		}
+
+		UEdGraph& Graph;
+		FDelegateHandle Handle;
+		int32 NumNotifications = 0;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSiriusFormatPinEditTest, "Sirius.Editor.FormatPin.IncrementalEdit", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSiriusFormatPinEditTest::RunTest(const FString& Parameters)
+{
+	using namespace SiriusFormatNodeTests;
+
+	UBlueprint* Blueprint = CreateBlueprint(TEXT("SiriusFormatPinEditTest"));
+	UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	// Typing literal text should only parse the pattern, and editing an argument should only replace its own pin,
+	// however many arguments the pattern has. The pins that are created and destroyed are counted to prove that.
+	constexpr int32 NumEdits = 100;
+	for (const int32 NumArgs : {4, 32, 256})
+	{
+		UK2Node_SiriusFormatString* Node = CreateFormatStringNode(*Graph);
+		const FString Pattern = MakePattern(NumArgs);
+		Schema->TrySetDefaultValue(*Node->GetFormatPin(), Pattern);
+		TestEqual(FString::Printf(TEXT("%d arguments create their pins"), NumArgs), Node->GetArgumentCount(), NumArgs);
+
+		const UEdGraphPin* FirstPin = Node->FindArgumentPin(TEXT("Arg0"));
+		const UEdGraphPin* LastPin = Node->FindArgumentPin(*FString::Printf(TEXT("Arg%d"), NumArgs - 1));
+
+		// Literal edits: no pin changes and no graph refresh.
+		double LiteralSeconds = 0.0;
+		{
+			FScopedGraphChangedCounter Counter(*Graph);
+			const TArray<UEdGraphPin*> PinsBefore = Node->Pins;
+			FString EditedPattern = Pattern;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 EditIdx = 0; EditIdx < NumEdits; ++EditIdx)
+			{
+				EditedPattern.AppendChar(TEXT('x'));
+				Schema->TrySetDefaultValue(*Node->GetFormatPin(), EditedPattern);
+			}
+			LiteralSeconds = FPlatformTime::Seconds() - StartTime;
+			TestEqual(TEXT("Literal edits don't refresh the graph"), Counter.NumNotifications, 0);
+			TestTrue(FString::Printf(TEXT("Literal edits don't touch any of the %d pins"), Node->Pins.Num()), Node->Pins == PinsBefore);
+		}
+
+		// Renaming the last argument: only its pin is replaced, with a single graph refresh per edit.
+		double ArgumentSeconds = 0.0;
+		{
+			FScopedGraphChangedCounter Counter(*Graph);
+			int32 NumCreatedPins = 0;
+			int32 NumDestroyedPins = 0;
+			for (int32 EditIdx = 0; EditIdx < NumEdits; ++EditIdx)
+			{
+				const TArray<UEdGraphPin*> PinsBefore = Node->Pins;
+				const FString EditedPattern = Pattern + FString::Printf(TEXT("{Edit%d}"), EditIdx);
+
+				const double StartTime = FPlatformTime::Seconds();
+				Schema->TrySetDefaultValue(*Node->GetFormatPin(), EditedPattern);
+				ArgumentSeconds += FPlatformTime::Seconds() - StartTime;
+
+				NumCreatedPins += CountPinsNotIn(Node->Pins, PinsBefore);
+				NumDestroyedPins += CountPinsNotIn(PinsBefore, Node->Pins);
+			}
+			TestEqual(TEXT("Argument edits refresh the graph once each"), Counter.NumNotifications, NumEdits);
+
+			// Every edit renames the last argument, the first one only adds it.
+			TestEqual(FString::Printf(TEXT("%d arguments: one pin is created per argument edit"), NumArgs), NumCreatedPins, NumEdits);
+			TestEqual(FString::Printf(TEXT("%d arguments: one pin is destroyed per argument edit"), NumArgs), NumDestroyedPins, NumEdits - 1);
+		}
+
+		TestEqual(TEXT("Only the edited argument pin was replaced"), Node->GetArgumentCount(), NumArgs + 1);
+		TestTrue(TEXT("Unchanged argument pins are kept"), Node->FindArgumentPin(TEXT("Arg0")) == FirstPin && Node->FindArgumentPin(*FString::Printf(TEXT("Arg%d"), NumArgs - 1)) == LastPin);
+		TestNotNull(TEXT("The last added argument has a pin"), Node->FindArgumentPin(*FString::Printf(TEXT("Edit%d"), NumEdits - 1)));
+		TestNull(TEXT("Removed arguments lost their pin"), Node->FindArgumentPin(TEXT("Edit0")));
+
+		AddInfo(FString::Printf(TEXT("%d arguments (%d characters): %.2f us per literal edit, %.2f us per argument edit"),
+		                        NumArgs, Pattern.Len(), LiteralSeconds * 1e6 / NumEdits, ArgumentSeconds * 1e6 / NumEdits));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSiriusReconstructBatchTest, "Sirius.Editor.FormatPin.ReconstructBatching", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSiriusReconstructBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace SiriusFormatNodeTests;
+
+	UBlueprint* Blueprint = CreateBlueprint(TEXT("SiriusReconstructBatchTest"));
+	UEdGraph* Graph = FBlueprintEditorUtils::FindEventGraph(Blueprint);
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	UEdGraphPin* SourcePin = CreateFloatSourcePin(*Graph);
+
+	// Hundreds of nodes with linked arguments, like a large Blueprint being loaded.
+	constexpr int32 NumNodes = 300;
+	constexpr int32 NumArgs = 8;
+	const FString Pattern = MakePattern(NumArgs);
+
+	TArray<UK2Node_SiriusFormatString*> Nodes;
+	for (int32 NodeIdx = 0; NodeIdx < NumNodes; ++NodeIdx)
+	{
+		UK2Node_SiriusFormatString* Node = CreateFormatStringNode(*Graph);
+		Schema->TrySetDefaultValue(*Node->GetFormatPin(), Pattern);
+		for (const FName& PinName : Node->GetArgumentPinNames())
+		{
+			UEdGraphPin* ArgumentPin = Node->FindArgumentPin(PinName);
+			ArgumentPin->MakeLinkTo(SourcePin);
+			Node->PinConnectionListChanged(ArgumentPin);
+		}
+		Nodes.Add(Node);
+	}
+
+	IConsoleVariable* BatchVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("Sirius.BatchPinNotifications"));
+	const bool bWasBatching = BatchVariable->GetBool();
+
+	// Reconstruction recreates the argument pins as wildcards, so every one of them changes type again.
+	// Runs both per node and through RefreshAllNodes like loading the Blueprint does, returning the number of graph notifications.
+	auto Reconstruct = [&](const bool bBatching, const bool bRefreshAll, double& OutSeconds)
+	{
+		BatchVariable->Set(bBatching, ECVF_SetByCode);
+		FScopedGraphChangedCounter Counter(*Graph);
+		const double StartTime = FPlatformTime::Seconds();
+		if (bRefreshAll)
+		{
+			FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
+		}
+		else
+		{
+			for (UK2Node_SiriusFormatString* Node : Nodes)
+			{
+				Node->ReconstructNode();
+			}
+		}
+		OutSeconds = FPlatformTime::Seconds() - StartTime;
+		return Counter.NumNotifications;
+	};
+
+	double UnbatchedSeconds = 0.0;
+	double BatchedSeconds = 0.0;
+	double UnbatchedRefreshSeconds = 0.0;
+	double BatchedRefreshSeconds = 0.0;
+	const int32 NumUnbatchedNotifications = Reconstruct(false, false, UnbatchedSeconds);
+	const int32 NumBatchedNotifications = Reconstruct(true, false, BatchedSeconds);
+	const int32 NumUnbatchedRefreshNotifications = Reconstruct(false, true, UnbatchedRefreshSeconds);
+	const int32 NumBatchedRefreshNotifications = Reconstruct(true, true, BatchedRefreshSeconds);
+	BatchVariable->Set(bWasBatching, ECVF_SetByCode);
+
+	for (UK2Node_SiriusFormatString* Node : Nodes)
+	{
+		if (Node->FindArgumentPin(TEXT("Arg0"))->PinType.PinCategory != UEdGraphSchema_K2::PC_Real)
+		{
+			AddError(TEXT("Argument pins did not take the type of their link after reconstruction"));
+			break;
+		}
+	}
+
+	// Without batching this is one notification per argument pin, NumNodes * NumArgs.
+	TestTrue(FString::Printf(TEXT("At most one graph notification per node (%d for %d nodes)"), NumBatchedNotifications, NumNodes), NumBatchedNotifications <= NumNodes);
+	TestTrue(FString::Printf(TEXT("Unbatched reconstruction notifies per pin (%d for %d pins)"), NumUnbatchedNotifications, NumNodes * NumArgs), NumUnbatchedNotifications >= NumNodes * NumArgs);
+	TestTrue(TEXT("Batching reduces the notifications of RefreshAllNodes"), NumBatchedRefreshNotifications < NumUnbatchedRefreshNotifications);
+
+	AddInfo(FString::Printf(TEXT("Reconstructed %d nodes with %d linked arguments: unbatched %.2f ms (%d notifications), batched %.2f ms (%d notifications)"),
+	                        NumNodes, NumArgs, UnbatchedSeconds * 1000.0, NumUnbatchedNotifications, BatchedSeconds * 1000.0, NumBatchedNotifications));
+	AddInfo(FString::Printf(TEXT("RefreshAllNodes: unbatched %.2f ms (%d notifications), batched %.2f ms (%d notifications)"),
+	                        UnbatchedRefreshSeconds * 1000.0, NumUnbatchedRefreshNotifications, BatchedRefreshSeconds * 1000.0, NumBatchedRefreshNotifications));
+	return true;
+}
+
+#endif
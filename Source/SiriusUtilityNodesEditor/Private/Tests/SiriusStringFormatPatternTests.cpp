@@ -0,0 +1,93 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusStringFormatPattern.h"
+#include "SiriusStringLibrary.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SiriusStringFormatPatternTests
+{
+	FSiriusStringFormatArgument MakeIntArgument(const TCHAR* Name, const int32 Value)
+	{
+		FSiriusStringFormatArgument Argument;
+		Argument.ArgumentName = Name;
+		Argument.ArgumentValueType = ESiriusStringFormatArgumentType::Int;
+		Argument.ArgumentValueInt = Value;
+		return Argument;
+	}
+
+	FSiriusStringFormatArgument MakeStringArgument(const TCHAR* Name, const TCHAR* Value)
+	{
+		FSiriusStringFormatArgument Argument;
+		Argument.ArgumentName = Name;
+		Argument.ArgumentValue = Value;
+		return Argument;
+	}
+
+	FString Format(const TCHAR* Pattern, const TArray<FSiriusStringFormatArgument>& Args)
+	{
+		return FSiriusStringFormatPattern(Pattern).Format(Args);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSiriusFormatPatternArgumentsTest, "Sirius.Editor.FormatPattern.Arguments", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSiriusFormatPatternArgumentsTest::RunTest(const FString& Parameters)
+{
+	using namespace SiriusStringFormatPatternTests;
+
+	const TArray<FSiriusStringFormatArgument> Args = {MakeIntArgument(TEXT("Count"), 3), MakeStringArgument(TEXT("Name"), TEXT("Bob"))};
+	TestEqual(TEXT("Arguments are replaced"), Format(TEXT("{Name} has {Count}"), Args), FString(TEXT("Bob has 3")));
+	TestEqual(TEXT("Missing arguments are left as-is"), Format(TEXT("Hello {Missing}"), Args), FString(TEXT("Hello {Missing}")));
+	TestEqual(TEXT("Escaped braces are literal"), Format(TEXT("`{Count`} {Count}"), Args), FString(TEXT("{Count} 3")));
+	TestEqual(TEXT("Unmatched braces are literal"), Format(TEXT("{Count} { }"), Args), FString(TEXT("3 { }")));
+	TestEqual(TEXT("Unknown specifiers leave the argument as-is"), Format(TEXT("{Count:zz}"), Args), FString(TEXT("{Count:zz}")));
+
+	TArray<FString> ArgumentNames;
+	FSiriusStringFormatPattern(TEXT("{A} {B|if({C})} {A}")).GetArgumentNames(ArgumentNames);
+	TestTrue(TEXT("Argument names are unique and include those of choices"), ArgumentNames == TArray<FString>({TEXT("A"), TEXT("B"), TEXT("C")}));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSiriusFormatPatternChoicesTest, "Sirius.Editor.FormatPattern.Choices", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSiriusFormatPatternChoicesTest::RunTest(const FString& Parameters)
+{
+	using namespace SiriusStringFormatPatternTests;
+
+	// Plural, "zero" falls back to "other".
+	const TCHAR* PluralPattern = TEXT("{Count} {Count|plural(one=item,other=items)}");
+	TestEqual(TEXT("Plural of 0"), Format(PluralPattern, {MakeIntArgument(TEXT("Count"), 0)}), FString(TEXT("0 items")));
+	TestEqual(TEXT("Plural of 1"), Format(PluralPattern, {MakeIntArgument(TEXT("Count"), 1)}), FString(TEXT("1 item")));
+	TestEqual(TEXT("Plural of 2"), Format(PluralPattern, {MakeIntArgument(TEXT("Count"), 2)}), FString(TEXT("2 items")));
+	TestEqual(TEXT("Plural with zero"), Format(TEXT("{Count|plural(zero=none,other=some)}"), {MakeIntArgument(TEXT("Count"), 0)}), FString(TEXT("none")));
+
+	// Select, with escaped separators and parentheses in its texts.
+	const TCHAR* SelectPattern = TEXT("{Mode|select(Fast=quick`, really,other=slow`))}");
+	TestEqual(TEXT("Select matching a key"), Format(SelectPattern, {MakeStringArgument(TEXT("Mode"), TEXT("Fast"))}), FString(TEXT("quick, really")));
+	TestEqual(TEXT("Select falling back to other"), Format(SelectPattern, {MakeStringArgument(TEXT("Mode"), TEXT("Normal"))}), FString(TEXT("slow)")));
+
+	// Conditionals with one or two texts.
+	TestEqual(TEXT("If with a true string"), Format(TEXT("[{bShow|if(shown)}]"), {MakeStringArgument(TEXT("bShow"), TEXT("true"))}), FString(TEXT("[shown]")));
+	TestEqual(TEXT("If with a false string"), Format(TEXT("[{bShow|if(shown)}]"), {MakeStringArgument(TEXT("bShow"), TEXT("false"))}), FString(TEXT("[]")));
+	TestEqual(TEXT("If otherwise with None"), Format(TEXT("[{bShow|if(shown,hidden)}]"), {MakeStringArgument(TEXT("bShow"), TEXT("None"))}), FString(TEXT("[hidden]")));
+	TestEqual(TEXT("If otherwise with 0"), Format(TEXT("[{bShow|if(shown,hidden)}]"), {MakeIntArgument(TEXT("bShow"), 0)}), FString(TEXT("[hidden]")));
+
+	// Arguments nested in the chosen text.
+	const TCHAR* NestedPattern = TEXT("{Count|plural(one={Name} has one,other={Name} has {Count})}");
+	TestEqual(TEXT("Nested arguments of one"), Format(NestedPattern, {MakeIntArgument(TEXT("Count"), 1), MakeStringArgument(TEXT("Name"), TEXT("Bob"))}), FString(TEXT("Bob has one")));
+	TestEqual(TEXT("Nested arguments of other"), Format(NestedPattern, {MakeIntArgument(TEXT("Count"), 3), MakeStringArgument(TEXT("Name"), TEXT("Bob"))}), FString(TEXT("Bob has 3")));
+
+	// Malformed choices and missing arguments are left in the result as they were written.
+	const TArray<FSiriusStringFormatArgument> CountArgs = {MakeIntArgument(TEXT("Count"), 1)};
+	TestEqual(TEXT("Unterminated choices are literal"), Format(TEXT("{Count|plural(one=item"), CountArgs), FString(TEXT("{Count|plural(one=item")));
+	TestEqual(TEXT("Choices without a closing brace are literal"), Format(TEXT("{Count|plural(one=item)"), CountArgs), FString(TEXT("{Count|plural(one=item)")));
+	TestEqual(TEXT("Unknown functions are literal"), Format(TEXT("{Count|bogus(x)} {Count}"), CountArgs), FString(TEXT("{Count|bogus(x)} 1")));
+	TestEqual(TEXT("Choices of missing arguments are left as-is"), Format(TEXT("{Missing|plural(one=a,other=b)}"), CountArgs), FString(TEXT("{Missing|plural(one=a,other=b)}")));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,243 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#include "SiriusPatternTable.h"
+#include "SiriusStringFormatPattern.h"
+#include "SiriusStringLibrary.h"
+#include "Engine/LatentActionManager.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SiriusStringLibraryTests
+{
+	/** Calls a library function through its thunk like the Blueprint VM does, with parameters filled in by name */
+	class FFunctionCall
+	{
+	public:
+		explicit FFunctionCall(const FName FunctionName)
+			: Function(USiriusStringLibrary::StaticClass()->FindFunctionByName(FunctionName))
+		{
+			Params.SetNumZeroed(Function->ParmsSize);
+			Function->InitializeStruct(Params.GetData());
+		}
+
+		~FFunctionCall()
+		{
+			Function->DestroyStruct(Params.GetData());
+		}
+
+		template <typename ValueType>
+		ValueType& Param(const FName ParamName)
+		{
+			return *Function->FindPropertyByName(ParamName)->ContainerPtrToValuePtr<ValueType>(Params.GetData());
+		}
+
+		template <typename ValueType>
+		ValueType& ReturnValue()
+		{
+			return *Function->GetReturnProperty()->ContainerPtrToValuePtr<ValueType>(Params.GetData());
+		}
+
+		void Call()
+		{
+			GetMutableDefault<USiriusStringLibrary>()->ProcessEvent(Function, Params.GetData());
+		}
+
+	private:
+		UFunction* Function;
+		TArray<uint8> Params;
+	};
+
+	/** Makes arguments with a single string value, named Value */
+	TArray<FSiriusStringFormatArgument> MakeValueArgs(const TCHAR* Value)
+	{
+		FSiriusStringFormatArgument Argument;
+		Argument.ArgumentName = TEXT("Value");
+		Argument.ArgumentValue = Value;
+		return {Argument};
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSiriusFormatArrayArgumentTest, "Sirius.Editor.Library.FormatArrayArgument", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSiriusFormatArrayArgumentTest::RunTest(const FString& Parameters)
+{
+	using namespace SiriusStringLibraryTests;
+
+	FFunctionCall FormatArrayArgument(GET_FUNCTION_NAME_CHECKED(USiriusStringLibrary, FormatArrayArgument));
+	FormatArrayArgument.Param<FString>(TEXT("ArgumentName")) = TEXT("Values");
+	FormatArrayArgument.Param<FString>(TEXT("Separator")) = TEXT(", ");
+
+	TArray<int32>& Values = FormatArrayArgument.Param<TArray<int32>>(TEXT("InArray"));
+	for (int32 Value = 0; Value < 100; ++Value)
+	{
+		Values.Add(Value);
+	}
+
+	FormatArrayArgument.Call();
+	const FSiriusStringFormatArgument& Argument = FormatArrayArgument.ReturnValue<FSiriusStringFormatArgument>();
+	TestEqual(TEXT("The argument is named"), Argument.ArgumentName, FString(TEXT("Values")));
+	TestTrue(TEXT("The argument is a string"), Argument.ArgumentValueType == ESiriusStringFormatArgumentType::String);
+	TestTrue(TEXT("All elements are formatted"), Argument.ArgumentValue.StartsWith(TEXT("0, 1, 2, ")) && Argument.ArgumentValue.EndsWith(TEXT(", 98, 99")));
+
+	// Calling it again, like an event graph does, overwrites the previous value in its existing allocation.
+	const int32 PreviousCapacity = Argument.ArgumentValue.GetCharArray().Max();
+	Values.SetNum(3);
+	FormatArrayArgument.Param<int32>(TEXT("MaxElements")) = 2;
+	FormatArrayArgument.Call();
+	TestEqual(TEXT("Elements over the limit are summarized"), Argument.ArgumentValue, FString(TEXT("0, 1, ... (1 more)")));
+	TestEqual(TEXT("The previous allocation is reused"), Argument.ArgumentValue.GetCharArray().Max(), PreviousCapacity);
+
+	Values.Reset();
+	FormatArrayArgument.Call();
+	TestTrue(TEXT("Empty arrays format as an empty string"), Argument.ArgumentValue.IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSiriusFormatBytesArgumentTest, "Sirius.Editor.Library.FormatBytesArgument", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSiriusFormatBytesArgumentTest::RunTest(const FString& Parameters)
+{
+	// What FormatArrayArgument produces for a byte array: the text of its elements and the bytes themselves.
+	FSiriusStringFormatArgument Argument;
+	Argument.ArgumentName = TEXT("Data");
+	Argument.ArgumentValueType = ESiriusStringFormatArgumentType::Bytes;
+	Argument.ArgumentValue = TEXT("1, 2, 255");
+	Argument.ArgumentValueBytes = {1, 2, 255};
+
+	const TArray<FSiriusStringFormatArgument> Args = {Argument};
+	TestEqual(TEXT("Plain byte arrays format as their elements"), USiriusStringLibrary::Format(TEXT("{Data}"), Args), FString(TEXT("1, 2, 255")));
+	TestEqual(TEXT("Hex encodes the bytes"), USiriusStringLibrary::Format(TEXT("{Data:x}"), Args), FString(TEXT("0102ff")));
+	TestEqual(TEXT("Upper case hex encodes the bytes"), USiriusStringLibrary::Format(TEXT("{Data:X}"), Args), FString(TEXT("0102FF")));
+	TestEqual(TEXT("Base64 encodes the bytes"), USiriusStringLibrary::Format(TEXT("{Data:b64}"), Args), USiriusStringLibrary::BytesToBase64(Argument.ArgumentValueBytes));
+
+	// The text is the same when elements are cut off, the bytes tell them apart.
+	FSiriusStringFormatArgument Other = Argument;
+	Other.ArgumentValueBytes.Add(0);
+	TestTrue(TEXT("Arguments with different bytes differ"), Argument != Other);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSiriusFormatNameCacheTest, "Sirius.Editor.Library.FormatNameCache", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSiriusFormatNameCacheTest::RunTest(const FString& Parameters)
+{
+	const FString Pattern = TEXT("Row_{Category}_{Index}");
+	const int64 PatternId = FSiriusPatternTable::GetPatternId(Pattern);
+
+	TArray<FSiriusStringFormatArgument> Args;
+	FSiriusStringFormatArgument& CategoryArg = Args.AddDefaulted_GetRef();
+	CategoryArg.ArgumentName = TEXT("Category");
+	CategoryArg.ArgumentValue = TEXT("Weapon");
+	FSiriusStringFormatArgument& IndexArg = Args.AddDefaulted_GetRef();
+	IndexArg.ArgumentName = TEXT("Index");
+	IndexArg.ArgumentValueType = ESiriusStringFormatArgumentType::Int;
+	IndexArg.ArgumentValueInt = 7;
+
+	const FName LiteralCallSite(TEXT("SiriusFormatNameCacheTest_Literal"));
+	const FName LinkedCallSite(TEXT("SiriusFormatNameCacheTest_Linked"));
+	TestEqual(TEXT("Literal patterns format the name"), USiriusStringLibrary::FormatName(LiteralCallSite, PatternId, Pattern, Args), FName(TEXT("Row_Weapon_7")));
+	TestEqual(TEXT("Literal patterns return the cached name"), USiriusStringLibrary::FormatName(LiteralCallSite, PatternId, Pattern, Args), FName(TEXT("Row_Weapon_7")));
+	TestEqual(TEXT("Linked patterns format the name"), USiriusStringLibrary::FormatName(LinkedCallSite, 0, Pattern, Args), FName(TEXT("Row_Weapon_7")));
+	TestEqual(TEXT("Linked patterns that changed are formatted again"), USiriusStringLibrary::FormatName(LinkedCallSite, 0, TEXT("Item_{Index}"), Args), FName(TEXT("Item_7")));
+
+	IndexArg.ArgumentValueInt = 8;
+	TestEqual(TEXT("Changed arguments are formatted again"), USiriusStringLibrary::FormatName(LiteralCallSite, PatternId, Pattern, Args), FName(TEXT("Row_Weapon_8")));
+
+	// A hit should cost less than formatting the name and looking it up in the name table, which is what it replaces.
+	constexpr int32 NumIterations = 10000;
+	const TArray<FSiriusStringFormatSegment> Segments = [&Pattern]
+	{
+		TArray<FSiriusStringFormatSegment> ParsedSegments;
+		FSiriusStringFormatPattern::Parse(Pattern, ParsedSegments);
+		return ParsedSegments;
+	}();
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		USiriusStringLibrary::FormatName(LiteralCallSite, PatternId, Pattern, Args);
+	}
+	const double LiteralHitSeconds = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		USiriusStringLibrary::FormatName(LinkedCallSite, 0, Pattern, Args);
+	}
+	const double LinkedHitSeconds = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		TStringBuilder<NAME_SIZE> Builder;
+		FSiriusStringFormatPattern::Format(Pattern, Segments, Args, Builder);
+		FName(Builder.Len(), Builder.GetData());
+	}
+	const double UncachedSeconds = FPlatformTime::Seconds() - StartTime;
+
+	AddInfo(FString::Printf(TEXT("Per name: %.1f ns cached literal pattern, %.1f ns cached linked pattern, %.1f ns formatting into FName(Builder)"),
+	                        LiteralHitSeconds * 1e9 / NumIterations, LinkedHitSeconds * 1e9 / NumIterations, UncachedSeconds * 1e9 / NumIterations));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSiriusFormatAsyncTest, "Sirius.Editor.Library.FormatAsync", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSiriusFormatAsyncTest::RunTest(const FString& Parameters)
+{
+	using namespace SiriusStringLibraryTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::None, false);
+	UObject* CallbackTarget = NewObject<UObject>(GetTransientPackage());
+	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+
+	// No linkage, so completing doesn't call into the target.
+	FLatentActionInfo LatentInfo;
+	LatentInfo.CallbackTarget = CallbackTarget;
+	LatentInfo.UUID = 1;
+	LatentInfo.Linkage = INDEX_NONE;
+
+	// Ticks the latent actions of the target like the world does every frame, until they finished or it takes too long.
+	auto WaitForCompletion = [&LatentActionManager, CallbackTarget]()
+	{
+		const double EndTime = FPlatformTime::Seconds() + 10.0;
+		do
+		{
+			LatentActionManager.BeginFrame();
+			LatentActionManager.ProcessLatentActions(CallbackTarget, 0.0f);
+			if (LatentActionManager.GetNumActionsForObject(CallbackTarget) == 0)
+			{
+				return true;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+		while (FPlatformTime::Seconds() < EndTime);
+		return false;
+	};
+
+	const FString Pattern = TEXT("Value is {Value}");
+	FString Result;
+	USiriusStringLibrary::FormatAsync(World, LatentInfo, 0, Pattern, MakeValueArgs(TEXT("First")), Result);
+	TestTrue(TEXT("The format completes"), WaitForCompletion());
+	TestEqual(TEXT("The result is set on completion"), Result, FString(TEXT("Value is First")));
+
+	// Executing the node again while it is formatting replaces the pending format instead of adding another action.
+	Result.Reset();
+	USiriusStringLibrary::FormatAsync(World, LatentInfo, 0, Pattern, MakeValueArgs(TEXT("Second")), Result);
+	USiriusStringLibrary::FormatAsync(World, LatentInfo, 0, Pattern, MakeValueArgs(TEXT("Third")), Result);
+	TestEqual(TEXT("A restart keeps a single action"), LatentActionManager.GetNumActionsForObject(CallbackTarget), 1);
+	TestTrue(TEXT("The restarted format completes"), WaitForCompletion());
+	TestEqual(TEXT("Only the latest arguments are output"), Result, FString(TEXT("Value is Third")));
+
+	// The actions write to Result, they must not outlive it.
+	LatentActionManager.RemoveActionsForObject(CallbackTarget);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
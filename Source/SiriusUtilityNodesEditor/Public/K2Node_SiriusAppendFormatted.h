@@ -0,0 +1,45 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node_SiriusFormatBase.h"
+#include "K2Node_SiriusAppendFormatted.generated.h"
+
+/**
+ * Appends a formatted string to a String Builder, without creating an intermediate string in the Blueprint VM.
+ */
+UCLASS(MinimalAPI)
+class UK2Node_SiriusAppendFormatted : public UK2Node_SiriusFormatBase
+{
+	GENERATED_BODY()
+
+public:
+	UK2Node_SiriusAppendFormatted();
+
+	//~ Begin UEdGraphNode Interface.
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetPinDisplayName(const UEdGraphPin* Pin) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+	//~ End UEdGraphNode Interface.
+
+	//~ Begin UK2Node Interface.
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	//~ End UK2Node Interface.
+
+protected:
+	//~ Begin UK2Node_SiriusFormatBase Interface.
+	virtual FName GetFormatPinName() const override { return FormatPinName; }
+	//~ End UK2Node_SiriusFormatBase Interface.
+
+private:
+	UEdGraphPin* GetExecutePin() const;
+	UEdGraphPin* GetThenPin() const;
+	UEdGraphPin* GetBuilderPin() const;
+
+	static const FName ExecutePinName;
+	static const FName ThenPinName;
+	static const FName BuilderPinName;
+	static const FName FormatPinName;
+};
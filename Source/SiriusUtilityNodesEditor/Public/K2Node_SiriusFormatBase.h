@@ -0,0 +1,171 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+#include "K2Node.h"
+#include "K2Node_SiriusFormatBase.generated.h"
+
+class FBlueprintActionDatabaseRegistrar;
+class FKismetCompilerContext;
+class UEdGraph;
+
+/** Map key funcs matching pin names case sensitively, the way argument pins are matched */
+struct FSiriusArgumentPinKeyFuncs : TDefaultMapKeyFuncs<FName, UEdGraphPin*, false>
+{
+	static FORCEINLINE bool Matches(const FName& A, const FName& B) { return A.IsEqual(B, ENameCase::CaseSensitive); }
+	static FORCEINLINE uint32 GetKeyHash(const FName& Key) { return GetTypeHash(Key); }
+};
+
+/** Time spent expanding Sirius nodes during Blueprint compilation and the number of intermediate nodes they created */
+struct SIRIUSUTILITYNODESEDITOR_API FSiriusExpansionStats
+{
+	double ExpandSeconds = 0.0;
+	int32 NumExpandedNodes = 0;
+	int32 NumIntermediateNodes = 0;
+
+	static FSiriusExpansionStats& Get();
+
+	void Reset() { *this = FSiriusExpansionStats(); }
+};
+
+/**
+ * Base for nodes with a Format pin using the "{}" argument syntax, which generates a wildcard argument pin for each argument.
+ * Keeps an index of the argument pins by name, so looking up an argument pin doesn't depend on the number of pins.
+ */
+UCLASS(Abstract, MinimalAPI)
+class UK2Node_SiriusFormatBase : public UK2Node
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UObject Interface
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
+	//~ End UObject Interface
+
+	//~ Begin UEdGraphNode Interface.
+	virtual void AllocateDefaultPins() override;
+	virtual void PinDefaultValueChanged(UEdGraphPin* Pin) override;
+	virtual void PinTypeChanged(UEdGraphPin* Pin) override;
+	virtual FText GetTooltipText() const override;
+	//~ End UEdGraphNode Interface.
+
+	//~ Begin UK2Node Interface.
+	virtual bool NodeCausesStructuralBlueprintChange() const override { return true; }
+	virtual void PostReconstructNode() override;
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	//~ End UK2Node Interface.
+
+	/** Returns Format pin */
+	SIRIUSUTILITYNODESEDITOR_API UEdGraphPin* GetFormatPin() const;
+
+	/**
+	 * Finds an argument pin by name, checking strings in a strict, case sensitive fashion
+	 *
+	 * @param InPinName		The pin name to check for
+	 * @return				NULL if the pin was not found, otherwise the found pin.
+	 */
+	SIRIUSUTILITYNODESEDITOR_API UEdGraphPin* FindArgumentPin(const FName InPinName) const;
+
+	/** Synchronize the type of the given argument pin with the type its connected to, or reset it to a wildcard pin if there's no connection */
+	SIRIUSUTILITYNODESEDITOR_API void SynchronizeArgumentPinType(UEdGraphPin* Pin) const;
+
+	/** Returns the names of all arguments, in order */
+	const TArray<FName>& GetArgumentPinNames() const { return PinNames; }
+
+	/** Broadcast when arguments were added, removed, renamed or reordered */
+	FSimpleMulticastDelegate& OnArgumentsChanged() { return ArgumentsChangedEvent; }
+
+protected:
+	/** Returns the name of the pin holding the pattern */
+	virtual FName GetFormatPinName() const PURE_VIRTUAL(UK2Node_SiriusFormatBase::GetFormatPinName, return NAME_None;);
+
+	/** Returns the direction of the argument pins, inputs for nodes formatting the arguments */
+	virtual EEdGraphPinDirection GetArgumentPinDirection() const { return EGPD_Input; }
+
+	/** Creates a wildcard argument pin after the existing ones, without adding it to PinNames */
+	UEdGraphPin* CreateArgumentPin(const FName InPinName);
+
+	/** Must be called after argument pins were added or removed without using CreateArgumentPin */
+	void InvalidateArgumentPinIndex();
+
+	/** Lets listeners like the details panel know PinNames changed */
+	void BroadcastArgumentsChanged() { ArgumentsChangedEvent.Broadcast(); }
+
+	/**
+	 * Expands the argument pins into a "Make Array" of FSiriusStringFormatArgument, converting the argument values where needed.
+	 *
+	 * @param ArgsPin		The pin taking the array of arguments, e.g. on the function call the node expands to.
+	 * @return				False if an argument could not be expanded, the error is reported to the compiler.
+	 */
+	bool ExpandArgumentPins(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph, UEdGraphPin* ArgsPin);
+
+	/** Adds the time and intermediate nodes of an ExpandNode call to FSiriusExpansionStats, declare it before expanding */
+	struct FScopedExpansionStats
+	{
+		explicit FScopedExpansionStats(const UEdGraph* InSourceGraph);
+		~FScopedExpansionStats();
+
+	private:
+		const UEdGraph* SourceGraph;
+		int32 StartNumNodes;
+		double StartTime;
+	};
+
+	/** When adding arguments to the node, their names are placed here and are generated as pins during construction */
+	UPROPERTY()
+	TArray<FName> PinNames;
+
+	/** Tooltip text for this node. */
+	FText NodeTooltip;
+
+	/** Placed between the elements of array arguments */
+	UPROPERTY(EditAnywhere, Category=Arrays)
+	FString ArraySeparator = TEXT(", ");
+
+	/** Maximum number of elements formatted per array argument, the remaining ones are summarized by their count. 0 formats all elements. */
+	UPROPERTY(EditAnywhere, Category=Arrays, meta=(ClampMin=0))
+	int32 MaxArrayElements = 0;
+
+private:
+	/**
+	 * Defers the graph and Blueprint notifications of argument pin type changes until the outermost scope ends, so
+	 * synchronizing all pins of the node at once refreshes the graph and marks the Blueprint as modified only once.
+	 * "Sirius.BatchPinNotifications 0" turns batching off, to measure its effect.
+	 */
+	struct FScopedNotificationBatch
+	{
+		explicit FScopedNotificationBatch(const UK2Node_SiriusFormatBase& InNode);
+		~FScopedNotificationBatch();
+
+	private:
+		const UK2Node_SiriusFormatBase& Node;
+		bool bBatching;
+	};
+
+	/** Lets the graph and Blueprint know an argument pin type changed, or defers it while batching */
+	void NotifyArgumentPinTypeChanged() const;
+
+	/** Rebuilds the argument pin index if it is out-of-date */
+	void UpdateArgumentPinIndex() const;
+
+	/** Creates an argument pin and adds it to the index, which must be up-to-date */
+	UEdGraphPin* CreateIndexedArgumentPin(const FName InPinName);
+
+	/** Argument pins by name, rebuilt whenever the pins of the node are reallocated */
+	mutable TMap<FName, UEdGraphPin*, FDefaultSetAllocator, FSiriusArgumentPinKeyFuncs> ArgumentPinIndex;
+
+	/** The format input pin, always available on the node */
+	mutable UEdGraphPin* CachedFormatPin = nullptr;
+
+	mutable bool bArgumentPinIndexDirty = true;
+
+	FSimpleMulticastDelegate ArgumentsChangedEvent;
+
+	mutable int32 NotificationBatchDepth = 0;
+	mutable bool bPendingTypeChangeNotification = false;
+};
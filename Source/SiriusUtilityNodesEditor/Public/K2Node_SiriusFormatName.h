@@ -0,0 +1,33 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node_SiriusFormatString.h"
+#include "K2Node_SiriusFormatName.generated.h"
+
+/**
+ * Format String variant producing a Name, for tags, socket names and row names.
+ * Each node remembers the names it produced by their argument values, so repeated combinations neither format nor look up the name again.
+ */
+UCLASS(MinimalAPI)
+class UK2Node_SiriusFormatName : public UK2Node_SiriusFormatString
+{
+	GENERATED_BODY()
+
+public:
+	explicit UK2Node_SiriusFormatName(const FObjectInitializer& ObjectInitializer);
+
+	//~ Begin UEdGraphNode Interface.
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	//~ End UEdGraphNode Interface.
+
+	//~ Begin UK2Node Interface.
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	//~ End UK2Node Interface.
+
+protected:
+	//~ Begin UK2Node_SiriusFormatString Interface.
+	virtual FName GetResultPinCategory() const override;
+	//~ End UK2Node_SiriusFormatString Interface.
+};
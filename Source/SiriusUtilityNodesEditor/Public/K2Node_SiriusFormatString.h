@@ -3,15 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "EdGraph/EdGraphPin.h"
-#include "K2Node.h"
+#include "K2Node_SiriusFormatBase.h"
 #include "K2Node_SiriusFormatString.generated.h"
 
-class FBlueprintActionDatabaseRegistrar;
+class FKismetCompilerContext;
 class UEdGraph;
 
 UCLASS(MinimalAPI)
-class UK2Node_SiriusFormatString : public UK2Node
+class UK2Node_SiriusFormatString : public UK2Node_SiriusFormatBase
 {
 	GENERATED_BODY()
 
@@ -27,38 +26,19 @@ public:
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 	virtual bool ShouldShowNodeProperties() const override { return true; }
 	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
-	virtual void PinDefaultValueChanged(UEdGraphPin* Pin) override;
-	virtual void PinTypeChanged(UEdGraphPin* Pin) override;
-	virtual FText GetTooltipText() const override;
 	virtual FText GetPinDisplayName(const UEdGraphPin* Pin) const override;
 	virtual TSharedPtr<SGraphNode> CreateVisualWidget() override;
 	//~ End UEdGraphNode Interface.
 
 	//~ Begin UK2Node Interface.
 	virtual bool IsNodePure() const override { return true; }
-	virtual bool NodeCausesStructuralBlueprintChange() const override { return true; }
-	virtual void PostReconstructNode() override;
 	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
 	virtual ERedirectType DoPinsMatchForReconstruction(const UEdGraphPin* NewPin, int32 NewPinIndex, const UEdGraphPin* OldPin, int32 OldPinIndex) const override;
-	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
-	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
-	virtual FText GetMenuCategory() const override;
 	//~ End UK2Node Interface.
 
-	/** Returns Format pin */
-	SIRIUSUTILITYNODESEDITOR_API UEdGraphPin* GetFormatPin() const;
-
 	/** Returns Result pin */
 	SIRIUSUTILITYNODESEDITOR_API UEdGraphPin* GetResultPin() const;
 
-	/**
-	 * Finds an argument pin by name, checking strings in a strict, case sensitive fashion
-	 *
-	 * @param InPinName		The pin name to check for
-	 * @return				NULL if the pin was not found, otherwise the found pin.
-	 */
-	SIRIUSUTILITYNODESEDITOR_API UEdGraphPin* FindArgumentPin(const FName InPinName) const;
-
 	/**
 	 * Add a new pin to the node. Intended for editor-time modification (e.g. details panel, custom slate button) */
 	SIRIUSUTILITYNODESEDITOR_API void AddArgumentPin();
@@ -71,9 +51,6 @@ public:
 	 */
 	SIRIUSUTILITYNODESEDITOR_API UEdGraphPin* AddArgumentPin(const FName InPinName);
 
-	/** Synchronize the type of the given argument pin with the type its connected to, or reset it to a wildcard pin if there's no connection */
-	SIRIUSUTILITYNODESEDITOR_API void SynchronizeArgumentPinType(UEdGraphPin* Pin) const;
-
 	bool CanEditArguments() const { return GetFormatPin()->LinkedTo.Num() > 0; }
 
 	/** Returns the number of arguments currently available in the node */
@@ -101,6 +78,17 @@ public:
 	/** Swaps two arguments by index */
 	void SwapArguments(int32 InIndexA, int32 InIndexB);
 
+protected:
+	//~ Begin UK2Node_SiriusFormatBase Interface.
+	virtual FName GetFormatPinName() const override { return FormatPinName; }
+	//~ End UK2Node_SiriusFormatBase Interface.
+
+	/** Returns the pin category of the Result pin, for variants producing a different type than a string */
+	virtual FName GetResultPinCategory() const;
+
+	/** Returns the call site name the cached format functions remember their previous results by */
+	FString GetCallSiteName(const FKismetCompilerContext& CompilerContext) const;
+
 private:
 	/** Returns a unique pin name to use for a pin */
 	FName GetUniquePinName() const;
@@ -108,13 +96,11 @@ private:
 	static const FName FormatPinName;
 	static const FName ResultPinName;
 
-	/** When adding arguments to the node, their names are placed here and are generated as pins during construction */
-	UPROPERTY()
-	TArray<FName> PinNames;
-
-	/** The "Format" input pin, always available on the node */
-	UEdGraphPin* CachedFormatPin;
-
-	/** Tooltip text for this node. */
-	FText NodeTooltip;
+	/**
+	 * Reuse the previous result while the pattern and argument values stay the same, e.g. for UMG bindings evaluated every frame.
+	 * Also use it when the Result is linked to several nodes: only the first of them formats, the others get the cached result.
+	 * The argument pins are still evaluated once per linked node, as for any pure node.
+	 */
+	UPROPERTY(EditAnywhere, Category=Performance)
+	bool bCacheResult;
 };
@@ -0,0 +1,39 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node_SiriusFormatString.h"
+#include "K2Node_SiriusFormatStringAsync.generated.h"
+
+/**
+ * Latent Format String variant for large outputs like reports and debug dumps, which formats on a background task.
+ * Completed fires on the game thread once the Result is available, it never fires if the calling object is destroyed first.
+ * Struct and array arguments are still converted to text on the game thread, as the argument values are made.
+ */
+UCLASS(MinimalAPI)
+class UK2Node_SiriusFormatStringAsync : public UK2Node_SiriusFormatString
+{
+	GENERATED_BODY()
+
+public:
+	explicit UK2Node_SiriusFormatStringAsync(const FObjectInitializer& ObjectInitializer);
+
+	//~ Begin UEdGraphNode Interface.
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetPinDisplayName(const UEdGraphPin* Pin) const override;
+	virtual bool IsCompatibleWithGraph(const UEdGraph* TargetGraph) const override;
+	//~ End UEdGraphNode Interface.
+
+	//~ Begin UK2Node Interface.
+	virtual bool IsNodePure() const override { return false; }
+	virtual FName GetCornerIcon() const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	//~ End UK2Node Interface.
+
+private:
+	UEdGraphPin* GetCompletedPin() const;
+
+	static const FName CompletedPinName;
+};
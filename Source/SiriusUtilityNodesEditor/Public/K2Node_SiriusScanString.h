@@ -0,0 +1,50 @@
+// Copyright 2022-2022 Jasper de Laat. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "K2Node_SiriusFormatBase.h"
+#include "K2Node_SiriusScanString.generated.h"
+
+/**
+ * The inverse of Format String: matches a string against a pattern and outputs the values of its arguments, converted to
+ * the type of the pins they are connected to. Matching and converting happens in a single native call.
+ */
+UCLASS(MinimalAPI)
+class UK2Node_SiriusScanString : public UK2Node_SiriusFormatBase
+{
+	GENERATED_BODY()
+
+public:
+	UK2Node_SiriusScanString();
+
+	//~ Begin UEdGraphNode Interface.
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetPinDisplayName(const UEdGraphPin* Pin) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+	//~ End UEdGraphNode Interface.
+
+	//~ Begin UK2Node Interface.
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	//~ End UK2Node Interface.
+
+protected:
+	//~ Begin UK2Node_SiriusFormatBase Interface.
+	virtual FName GetFormatPinName() const override { return PatternPinName; }
+	virtual EEdGraphPinDirection GetArgumentPinDirection() const override { return EGPD_Output; }
+	//~ End UK2Node_SiriusFormatBase Interface.
+
+private:
+	UEdGraphPin* GetExecutePin() const;
+	UEdGraphPin* GetThenPin() const;
+	UEdGraphPin* GetSourcePin() const;
+	UEdGraphPin* GetSuccessPin() const;
+
+	static const FName ExecutePinName;
+	static const FName ThenPinName;
+	static const FName SourcePinName;
+	static const FName PatternPinName;
+	static const FName SuccessPinName;
+};
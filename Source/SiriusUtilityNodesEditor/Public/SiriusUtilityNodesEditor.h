@@ -10,4 +10,8 @@ class FSiriusUtilityNodesEditorModule final : public IModuleInterface
 public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	/** Adds the Sirius entries to the graph node context menus */
+	void RegisterMenus();
 };
@@ -25,17 +25,20 @@ public class SiriusUtilityNodesEditor : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"AssetRegistry",
 				"Core",
 				"CoreUObject",
 				"Engine",
 				"EditorStyle",
+				"Json",
 				"PropertyEditor",
 				"SlateCore",
 				"Slate",
 				"GraphEditor",
 				"UnrealEd",
 				"KismetCompiler", 
-				"SiriusUtilityNodes"
+				"SiriusUtilityNodes",
+				"ToolMenus"
 			}
 		);
 	}